@@ -58,7 +58,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
-    *const_cast<bool *>(&context.has_sse42) = false;
+    context.kernels = &kernel_table_for(kernel_tier::scalar);
     write_escaped(context, begin, begin + input.size());
     n += context.size();
   });
@@ -73,6 +73,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string_sse42) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
+    context.kernels = &kernel_table_for(kernel_tier::sse42);
     write_escaped(context, begin, begin + input.size());
     n += context.size();
   });
@@ -80,6 +81,40 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string_sse42) {
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string_avx2) {
+  const auto input = generate_string(8192, false);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    context.kernels = &kernel_table_for(kernel_tier::avx2);
+    write_escaped(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string_avx512) {
+  const auto input = generate_string(8192, false);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    context.kernels = &kernel_table_for(kernel_tier::avx512);
+    write_escaped(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512)
+
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string) {
   const auto input = generate_string(8192, true);
   const auto begin = input.data();
@@ -87,7 +122,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
-    *const_cast<bool *>(&context.has_sse42) = false;
+    context.kernels = &kernel_table_for(kernel_tier::scalar);
     write_escaped(context, begin, begin + input.size());
     n += context.size();
   });
@@ -102,6 +137,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string_sse42) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
+    context.kernels = &kernel_table_for(kernel_tier::sse42);
     write_escaped(context, begin, begin + input.size());
     n += context.size();
   });
@@ -109,6 +145,40 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string_sse42) {
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string_avx2) {
+  const auto input = generate_string(8192, true);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    context.kernels = &kernel_table_for(kernel_tier::avx2);
+    write_escaped(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string_avx512) {
+  const auto input = generate_string(8192, true);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    context.kernels = &kernel_table_for(kernel_tier::avx512);
+    write_escaped(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512)
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
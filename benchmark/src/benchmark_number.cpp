@@ -14,10 +14,12 @@
  * the License.
  */
 
+#include <cstdio>
 #include <string>
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/array.hpp>
 #include <spotify/json/codec/number.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/encode.hpp>
@@ -73,6 +75,90 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_positive_uint64_t) {
   });
 }
 
+namespace {
+
+/**
+ * A JSON array of n doubles, like the feature vectors of a ranking request:
+ * short decimals mixed with full precision values and exponents.
+ */
+std::string make_double_array(size_t n) {
+  std::string json = "[";
+  char buffer[32];
+  for (size_t i = 0; i < n; i++) {
+    const auto value = (double(i * 7919 % 10007) - 5003.0) / 997.0;
+    const char *format = (i % 3 == 0 ? "%.3f" : i % 3 == 1 ? "%.17g" : "%.6e");
+    std::snprintf(buffer, sizeof(buffer), format, value);
+    json += (i ? "," : "");
+    json += buffer;
+  }
+  return json + "]";
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_double_array) {
+  const auto codec = array<std::vector<double>>(number<double>());
+  const auto json = make_double_array(10000);
+  JSON_BENCHMARK(1e3, [=]{
+    decode(codec, json);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_float_array) {
+  const auto codec = array<std::vector<float>>(number<float>());
+  const auto json = make_double_array(10000);
+  JSON_BENCHMARK(1e3, [=]{
+    decode(codec, json);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_double_array) {
+  const auto codec = array<std::vector<double>>(number<double>());
+  const auto values = decode(codec, make_double_array(10000));
+  JSON_BENCHMARK(1e3, [=]{
+    encode(codec, values);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_float_array) {
+  const auto codec = array<std::vector<float>>(number<float>());
+  const auto values = decode(codec, make_double_array(10000));
+  JSON_BENCHMARK(1e3, [=]{
+    encode(codec, values);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_integral_double) {
+  const auto codec = number<double>();
+  JSON_BENCHMARK(1e6, [=]{
+    encode(codec, 1234567.0);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_timestamp_array) {
+  const auto codec = array<std::vector<int64_t>>(number<int64_t>());
+  std::string json = "[";
+  for (int64_t i = 0; i < 10000; i++) {
+    json += (i ? "," : "") + std::to_string(1571234567890LL + i * 7919);
+  }
+  json += "]";
+  JSON_BENCHMARK(1e3, [=]{
+    decode(codec, json);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_id_array) {
+  const auto codec = array<std::vector<uint64_t>>(number<uint64_t>());
+  std::string json = "[";
+  for (uint64_t i = 0; i < 10000; i++) {
+    json += (i ? "," : "") + std::to_string(12345678901234567890ULL - i * 104729104729ULL);
+  }
+  json += "]";
+  JSON_BENCHMARK(1e3, [=]{
+    decode(codec, json);
+  });
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -14,16 +14,25 @@
  * the License.
  */
 
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include <sstream>
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/number.hpp>
 #include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/static_object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/cursor.hpp>
 #include <spotify/json/decode.hpp>
+#include <spotify/json/decode_batch.hpp>
 #include <spotify/json/decode_exception.hpp>
 #include <spotify/json/encode.hpp>
+#include <spotify/json/extract.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
 
@@ -84,6 +93,150 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_many_required_field
   });
 }
 
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_three_of_many_fields) {
+  const auto codec = required_codec(3);
+  const auto json = make_json(1000);
+
+  JSON_BENCHMARK(1e4, [=]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_cursor_read_three_of_many_fields) {
+  const auto json = make_json(1000);
+
+  volatile int n = 0;
+  JSON_BENCHMARK(1e4, [&]{
+    const cursor root(json.data(), json.size());
+    n += root["a10"].get<int>() + root["m20"].get<int>() + root["y39"].get<int>();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_extract_three_of_many_fields) {
+  const extractor three_fields({ "/a10", "/m20", "/y39" });
+  const auto json = make_json(1000);
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e4, [&]{
+    n += three_fields.extract(json.data(), json.size())[2]->size();
+  });
+}
+
+struct track_t {
+  std::string uri;
+  std::string name;
+  int64_t duration_ms = 0;
+  int32_t track_number = 0;
+  int32_t disc_number = 0;
+  int32_t popularity = 0;
+  bool is_explicit = false;
+  bool is_playable = false;
+};
+
+object_t<track_t> dynamic_track_codec() {
+  object_t<track_t> codec;
+  codec.required("uri", &track_t::uri);
+  codec.required("name", &track_t::name);
+  codec.required("duration_ms", &track_t::duration_ms);
+  codec.required("track_number", &track_t::track_number);
+  codec.required("disc_number", &track_t::disc_number);
+  codec.required("popularity", &track_t::popularity);
+  codec.required("explicit", &track_t::is_explicit);
+  codec.required("is_playable", &track_t::is_playable);
+  return codec;
+}
+
+auto static_track_codec() {
+  return static_object<track_t>(
+      required_field("uri", &track_t::uri),
+      required_field("name", &track_t::name),
+      required_field("duration_ms", &track_t::duration_ms),
+      required_field("track_number", &track_t::track_number),
+      required_field("disc_number", &track_t::disc_number),
+      required_field("popularity", &track_t::popularity),
+      required_field("explicit", &track_t::is_explicit),
+      required_field("is_playable", &track_t::is_playable));
+}
+
+const std::string track_json =
+    R"({"uri":"spotify:track:6rqhFgbbKwnb9MLmUQDhG6","name":"Speak to Me",)"
+    R"("duration_ms":90173,"track_number":1,"disc_number":1,"popularity":62,)"
+    R"("explicit":false,"is_playable":true})";
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_track) {
+  const auto codec = dynamic_track_codec();
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_decode_track) {
+  const auto codec = static_track_codec();
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_into_track) {
+  const auto codec = dynamic_track_codec();
+  track_t track;
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+    codec.decode_into(context, track);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_decode_into_track) {
+  const auto codec = static_track_codec();
+  track_t track;
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+    codec.decode_into(context, track);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_track_records) {
+  const auto codec = dynamic_track_codec();
+  const std::vector<std::string> records(1000, track_json);
+  JSON_BENCHMARK(1e3, [&]{
+    for (const auto &record : records) {
+      decode(codec, record);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_batch_track_records) {
+  const auto codec = dynamic_track_codec();
+  const std::vector<std::string> records(1000, track_json);
+  std::vector<track_t> tracks;
+  tracks.reserve(records.size());
+  JSON_BENCHMARK(1e3, [&]{
+    tracks.clear();
+    decode_batch(codec, records, std::back_inserter(tracks));
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_encode_track) {
+  const auto codec = dynamic_track_codec();
+  const auto track = decode(codec, track_json);
+  JSON_BENCHMARK(1e6, [&]{
+    encode_context context;
+    codec.encode(context, track);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_encode_track) {
+  const auto codec = static_track_codec();
+  const auto track = decode(codec, track_json);
+  JSON_BENCHMARK(1e6, [&]{
+    encode_context context;
+    codec.encode(context, track);
+  });
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
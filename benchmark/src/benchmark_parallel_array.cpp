@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/parallel_array.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+struct catalog_track_t {
+  std::string uri;
+  std::string name;
+  int64_t duration_ms = 0;
+};
+
+object_t<catalog_track_t> catalog_track_codec() {
+  object_t<catalog_track_t> codec;
+  codec.required("uri", &catalog_track_t::uri);
+  codec.required("name", &catalog_track_t::name);
+  codec.required("duration_ms", &catalog_track_t::duration_ms);
+  return codec;
+}
+
+std::string make_catalog_json(const size_t num_tracks) {
+  std::string json = "[";
+  for (size_t i = 0; i < num_tracks; i++) {
+    json += (i ? "," : "");
+    json += R"({"uri":"spotify:track:6rqhFgbbKwnb9MLmUQDhG6","name":"Speak to Me",)";
+    json += R"("duration_ms":)" + std::to_string(90173 + i) + "}";
+  }
+  return json + "]";
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_array_decode_catalog) {
+  const auto codec = array<std::vector<catalog_track_t>>(catalog_track_codec());
+  const auto json = make_catalog_json(100000);
+  JSON_BENCHMARK(10, [&]{
+    decode(codec, json);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_parallel_array_decode_catalog) {
+  const auto codec = parallel_array<std::vector<catalog_track_t>>(catalog_track_codec());
+  const auto json = make_catalog_json(100000);
+  JSON_BENCHMARK(10, [&]{
+    decode(codec, json);
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -15,12 +15,18 @@
  */
 
 #include <string>
+#include <string_view>
 
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/kernels.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/detail/structural_index.hpp>
+#include <spotify/json/document.hpp>
+#include <spotify/json/parse.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
 
@@ -47,7 +53,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e6, [&]{
     auto context = decode_context(json.data(), json.data() + json.size());
-    *const_cast<bool *>(&context.has_sse42) = false;
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::scalar);
     detail::skip_any_simple_characters(context);
     n += context.offset();
   });
@@ -60,6 +66,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_sse42) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e6, [&]{
     auto context = decode_context(json.data(), json.data() + json.size());
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::sse42);
     detail::skip_any_simple_characters(context);
     n += context.offset();
   });
@@ -67,6 +74,36 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_sse42) {
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_avx2) {
+  const auto json = generate_simple_string(8192);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::avx2);
+    detail::skip_any_simple_characters(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_avx512) {
+  const auto json = generate_simple_string(8192);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::avx512);
+    detail::skip_any_simple_characters(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512)
+
 std::string generate_whitespace_string(size_t size) {
   std::string string;
   for (size_t i = 0; i < size; i++) {
@@ -87,7 +124,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e6, [&]{
     auto context = decode_context(json.data(), json.data() + json.size());
-    *const_cast<bool *>(&context.has_sse42) = false;
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::scalar);
     detail::skip_any_whitespace(context);
     n += context.offset();
   });
@@ -100,6 +137,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_sse42) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e6, [&]{
     auto context = decode_context(json.data(), json.data() + json.size());
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::sse42);
     detail::skip_any_whitespace(context);
     n += context.offset();
   });
@@ -107,6 +145,97 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_sse42) {
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_avx2) {
+  const auto json = generate_whitespace_string(8192);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::avx2);
+    detail::skip_any_whitespace(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_avx512) {
+  const auto json = generate_whitespace_string(8192);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::avx512);
+    detail::skip_any_whitespace(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512)
+
+std::string generate_nested_json(size_t num_records) {
+  std::string json = "[";
+  for (size_t i = 0; i < num_records; i++) {
+    json += (i ? "," : "");
+    json += "{\"id\":" + std::to_string(i) + ",\"name\":\"record [" + std::to_string(i) + "]\",";
+    json += "\"tags\":[\"a\",\"b\",\"c\\\"d\"],\"location\":{\"lat\":1.5,\"lon\":-2.25},";
+    json += "\"flags\":[true,false,null],\"children\":[[1,2],[3,4],{\"x\":{}}]}";
+  }
+  return json + "]";
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value) {
+  const auto json = generate_nested_json(1000);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e3, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    detail::skip_value(context);
+    n += context.offset();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_with_structural_index) {
+  const auto json = generate_nested_json(1000);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e3, [&]{
+    const detail::structural_index index(json.data(), json.data() + json.size());
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.structural_index = &index;
+    detail::skip_value(context);
+    n += context.offset();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_parse_with_counting_handler) {
+  struct counting_handler : public parse_handler {
+    bool number_raw(std::string_view) {
+      count++;
+      return true;
+    }
+
+    size_t count = 0;
+  };
+
+  const auto json = generate_nested_json(1000);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e3, [&]{
+    counting_handler handler;
+    parse(handler, json);
+    n += handler.count;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_build_document) {
+  const auto json = generate_nested_json(1000);
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e3, [&]{
+    const document doc(json.data(), json.size());
+    n += doc.tape_size();
+  });
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
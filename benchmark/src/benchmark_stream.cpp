@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_stream.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct stream_track_t {
+  std::string uri;
+  std::string name;
+  int64_t duration_ms = 0;
+  int32_t popularity = 0;
+  bool is_playable = false;
+};
+
+codec::object_t<stream_track_t> stream_track_codec() {
+  codec::object_t<stream_track_t> codec;
+  codec.required("uri", &stream_track_t::uri);
+  codec.required("name", &stream_track_t::name);
+  codec.required("duration_ms", &stream_track_t::duration_ms);
+  codec.required("popularity", &stream_track_t::popularity);
+  codec.required("is_playable", &stream_track_t::is_playable);
+  return codec;
+}
+
+std::string make_track_ndjson(const size_t num_records) {
+  std::string json;
+  for (size_t i = 0; i < num_records; i++) {
+    json += R"({"uri":"spotify:track:6rqhFgbbKwnb9MLmUQDhG6","name":"Speak to Me",)";
+    json += R"("duration_ms":)" + std::to_string(90173 + i) + R"(,"popularity":62,)";
+    json += R"("is_playable":true})" "\n";
+  }
+  return json;
+}
+
+decode_stream_options options_with_threads(const size_t num_threads) {
+  decode_stream_options options;
+  options.num_threads = num_threads;
+  return options;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_decode_stream_ndjson_one_thread) {
+  const auto codec = stream_track_codec();
+  const auto json = make_track_ndjson(100000);
+  JSON_BENCHMARK(10, [&]{
+    decode_stream(codec, json, options_with_threads(1));
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_decode_stream_ndjson_all_threads) {
+  const auto codec = stream_track_codec();
+  const auto json = make_track_ndjson(100000);
+  JSON_BENCHMARK(10, [&]{
+    decode_stream(codec, json, options_with_threads(0));
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -15,12 +15,15 @@
  */
 
 #include <string>
+#include <string_view>
 
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/codec/string.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/macros.hpp>
 #include <spotify/json/encode.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
@@ -59,10 +62,59 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_long_string) {
   const auto json_end = json.data() + json.size();
   JSON_BENCHMARK(1e5, [=]{
     auto context = decode_context(json_begin, json_end);
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::scalar);
     const auto decoded_string = codec.decode(context);
   });
 }
 
+#if defined(json_arch_x86_sse42)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_long_string_sse42) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_simple_json_string(10000);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json_begin, json_end);
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::sse42);
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+#endif  // defined(json_arch_x86_sse42)
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_long_string_avx2) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_simple_json_string(10000);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json_begin, json_end);
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::avx2);
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_long_string_avx512) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_simple_json_string(10000);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json_begin, json_end);
+    context.kernels = &detail::kernel_table_for(detail::kernel_tier::avx512);
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512)
+
 BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_string) {
   const auto codec = default_codec<std::string>();
   const auto json = std::string("\"spotify:track:05341EWu6uHUg2BojF3Cyw\"");
@@ -76,6 +128,19 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_string) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_view_decode_simple_tiny_string) {
+  const auto codec = default_codec<std::string_view>();
+  const auto json = std::string("\"spotify:track:05341EWu6uHUg2BojF3Cyw\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
 /*
  * Encoding
  */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/json_pointer.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A single pass input range over the elements of a JSON array, which decodes
+ * one element at a time with a codec, as the range is iterated. Only the
+ * current element is kept in memory, and it is decoded into (see decode_into)
+ * when the iterator is advanced, so that its memory is reused.
+ *
+ * The array is either the whole document, or the value that a JSON Pointer
+ * refers to. The input must outlive the range. Nothing after the end of the
+ * array is read, and decode errors are thrown from begin() and operator++.
+ */
+template <typename codec_type>
+class array_elements_t final {
+ public:
+  using value_type = typename codec_type::object_type;
+
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename codec_type::object_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    iterator() = default;
+    explicit iterator(array_elements_t *elements) : _elements(elements) {}
+
+    reference operator*() const { return *_elements->_element; }
+    pointer operator->() const { return &*_elements->_element; }
+
+    iterator &operator++() {
+      _elements->advance();
+      return *this;
+    }
+
+    void operator++(int) {
+      ++*this;
+    }
+
+    bool operator==(const iterator &other) const {
+      return at_end() == other.at_end();
+    }
+
+    bool operator!=(const iterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    bool at_end() const {
+      return !_elements || _elements->_done;
+    }
+
+    array_elements_t *_elements = nullptr;
+  };
+
+  array_elements_t(codec_type codec, const char *data, size_t size, std::string_view pointer)
+      : _codec(std::move(codec)),
+        _tokens(detail::parse_json_pointer(pointer)),
+        _context(data, data + size) {}
+
+  /**
+   * Find the array and decode its first element. Like for any input range,
+   * begin() must only be called once.
+   */
+  iterator begin() {
+    detail::skip_any_whitespace(_context);
+    detail::seek_json_pointer(_context, _tokens);
+    detail::skip_1(_context, '[');
+    detail::skip_any_whitespace(_context);
+    if (detail::peek(_context) == ']') {
+      finish();
+    } else {
+      decode_element();
+    }
+    return iterator(this);
+  }
+
+  iterator end() {
+    return iterator();
+  }
+
+  /**
+   * The decode_context that the elements are decoded with, for setting up a
+   * memory_resource or a structural_index before iterating.
+   */
+  decode_context &context() {
+    return _context;
+  }
+
+ private:
+  void advance() {
+    detail::skip_any_whitespace(_context);
+    const auto c = detail::next(_context, "Expected ']'");
+    if (c == ']') {
+      finish();
+      return;
+    }
+
+    detail::fail_if(_context, c != ',', "Expected ',' or ']'", -1);
+    detail::skip_any_whitespace(_context);
+    decode_element();
+  }
+
+  void decode_element() {
+    if (_element) {
+      detail::decode_into(_codec, _context, *_element);
+    } else {
+      _element.emplace(_codec.decode(_context));
+    }
+  }
+
+  void finish() {
+    _done = true;
+    _element.reset();
+  }
+
+  codec_type _codec;
+  std::vector<std::string> _tokens;
+  decode_context _context;
+  std::optional<value_type> _element;
+  bool _done = false;
+};
+
+/*
+ * json::array_elements(codec, data..., pointer)
+ *
+ * Iterate over the elements of the array in data, or of the array that the
+ * JSON Pointer pointer (such as "/catalog/tracks") refers to:
+ *
+ *   for (const auto &track : array_elements(track_codec, json, "/tracks")) {
+ *     ...
+ *   }
+ */
+
+template <typename codec_type>
+array_elements_t<codec_type> array_elements(
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    std::string_view pointer = std::string_view()) {
+  return array_elements_t<codec_type>(codec, data, size, pointer);
+}
+
+template <typename codec_type, typename string_type>
+array_elements_t<codec_type> array_elements(
+    const codec_type &codec,
+    const string_type &string,
+    std::string_view pointer = std::string_view()) {
+  return array_elements_t<codec_type>(codec, string.data(), string.size(), pointer);
+}
+
+template <typename value_type, typename string_type>
+array_elements_t<decltype(default_codec<value_type>())> array_elements(
+    const string_type &string,
+    std::string_view pointer = std::string_view()) {
+  return array_elements(default_codec<value_type>(), string, pointer);
+}
+
+}  // namespace json
+}  // namespace spotify
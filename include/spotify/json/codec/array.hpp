@@ -19,6 +19,7 @@
 #include <array>
 #include <deque>
 #include <list>
+#include <memory_resource>
 #include <set>
 #include <type_traits>
 #include <unordered_set>
@@ -37,6 +38,12 @@ namespace detail {
 struct sequence_inserter {
   using state = int;
   static const state init_state = 0;
+  static const bool reuses_elements = false;
+
+  template <typename container_type>
+  static void clear(container_type &container) {
+    container.clear();
+  }
 
   template <typename container_type, typename value_type>
   static state insert(
@@ -57,6 +64,12 @@ struct sequence_inserter {
 struct fixed_size_sequence_inserter {
   using state = size_t;
   static const state init_state = 0;
+  static const bool reuses_elements = false;
+
+  template <typename container_type>
+  static void clear(container_type &) {
+    // Every element is overwritten, or validate fails
+  }
 
   template <typename container_type, typename value_type>
   static state insert(
@@ -78,6 +91,12 @@ struct fixed_size_sequence_inserter {
 struct associative_inserter {
   using state = int;
   static const state init_state = 0;
+  static const bool reuses_elements = false;
+
+  template <typename container_type>
+  static void clear(container_type &container) {
+    container.clear();
+  }
 
   template <typename container_type, typename value_type>
   static state insert(
@@ -95,25 +114,33 @@ struct associative_inserter {
   }
 };
 
+/**
+ * Inserter for sequences that can be decoded into element by element, so that
+ * decode_into reuses the memory of the elements that are already there.
+ */
+struct random_access_sequence_inserter : public sequence_inserter {
+  static const bool reuses_elements = true;
+};
+
 template <typename T> struct container_inserter;
 
-template <typename T>
-struct container_inserter<std::vector<T>> : public sequence_inserter {};
+template <typename T, typename Allocator>
+struct container_inserter<std::vector<T, Allocator>> : public random_access_sequence_inserter {};
 
-template <typename T>
-struct container_inserter<std::deque<T>> : public sequence_inserter {};
+template <typename T, typename Allocator>
+struct container_inserter<std::deque<T, Allocator>> : public random_access_sequence_inserter {};
 
-template <typename T>
-struct container_inserter<std::list<T>> : public sequence_inserter {};
+template <typename T, typename Allocator>
+struct container_inserter<std::list<T, Allocator>> : public sequence_inserter {};
 
 template <typename T, size_t Size>
 struct container_inserter<std::array<T, Size>> : public fixed_size_sequence_inserter {};
 
-template <typename T>
-struct container_inserter<std::set<T>> : public associative_inserter {};
+template <typename T, typename Compare, typename Allocator>
+struct container_inserter<std::set<T, Compare, Allocator>> : public associative_inserter {};
 
-template <typename T>
-struct container_inserter<std::unordered_set<T>> : public associative_inserter {};
+template <typename T, typename Hash, typename KeyEqual, typename Allocator>
+struct container_inserter<std::unordered_set<T, Hash, KeyEqual, Allocator>> : public associative_inserter {};
 
 }  // namespace detail
 
@@ -140,7 +167,7 @@ class array_t final {
 
   object_type decode(decode_context &context) const {
     using inserter = detail::container_inserter<T>;
-    object_type output;
+    auto output = detail::construct<object_type>(context);
     typename inserter::state state = inserter::init_state;
     detail::decode_comma_separated(context, '[', ']', [&]{
       state = inserter::insert(
@@ -150,6 +177,33 @@ class array_t final {
     return output;
   }
 
+  void decode_into(decode_context &context, object_type &output) const {
+    using inserter = detail::container_inserter<T>;
+    // std::vector<bool> has no element references to decode into
+    if constexpr (
+        inserter::reuses_elements &&
+        std::is_same<typename T::reference, typename T::value_type &>::value) {
+      size_t size = 0;
+      detail::decode_comma_separated(context, '[', ']', [&]{
+        if (size < output.size()) {
+          detail::decode_into(_inner_codec, context, output[size]);
+        } else {
+          output.push_back(_inner_codec.decode(context));
+        }
+        size++;
+      });
+      output.erase(output.begin() + size, output.end());
+    } else {
+      inserter::clear(output);
+      typename inserter::state state = inserter::init_state;
+      detail::decode_comma_separated(context, '[', ']', [&]{
+        state = inserter::insert(
+            context, state, output, _inner_codec.decode(context));
+      });
+      inserter::validate(context, state, output);
+    }
+  }
+
   void encode(encode_context &context, const object_type &array) const {
     context.append('[');
     for (const auto &element : array) {
@@ -179,6 +233,13 @@ struct default_codec_t<std::vector<T>> {
   }
 };
 
+template <typename T>
+struct default_codec_t<std::pmr::vector<T>> {
+  static decltype(codec::array<std::pmr::vector<T>>(default_codec<T>())) codec() {
+    return codec::array<std::pmr::vector<T>>(default_codec<T>());
+  }
+};
+
 template <typename T>
 struct default_codec_t<std::deque<T>> {
   static decltype(codec::array<std::deque<T>>(default_codec<T>())) codec() {
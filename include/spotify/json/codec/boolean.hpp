@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/encode_context.hpp>
@@ -28,6 +30,8 @@ class boolean_t final {
  public:
   using object_type = bool;
 
+  static constexpr std::size_t max_encoded_size = 5;  // false
+
   object_type decode(decode_context &context) const;
   void encode(encode_context &context, const object_type value) const;
 };
@@ -22,6 +22,7 @@
 #include <spotify/json/codec/boolean.hpp>
 #include <spotify/json/codec/cast.hpp>
 #include <spotify/json/codec/chrono.hpp>
+#include <spotify/json/codec/document.hpp>
 #include <spotify/json/codec/empty_as.hpp>
 #include <spotify/json/codec/enumeration.hpp>
 #include <spotify/json/codec/eq.hpp>
@@ -33,7 +34,9 @@
 #include <spotify/json/codec/omit.hpp>
 #include <spotify/json/codec/one_of.hpp>
 #include <spotify/json/codec/optional.hpp>
+#include <spotify/json/codec/parallel_array.hpp>
 #include <spotify/json/codec/smart_ptr.hpp>
+#include <spotify/json/codec/static_object.hpp>
 #include <spotify/json/codec/string.hpp>
 #include <spotify/json/codec/transform.hpp>
 #include <spotify/json/codec/tuple.hpp>
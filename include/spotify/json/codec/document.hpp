@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/document.hpp>
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+
+class document_t final {
+ public:
+  using object_type = json::document;
+
+  object_type decode(decode_context &context) const;
+  void encode(encode_context &context, const object_type &value) const;
+};
+
+inline document_t document() {
+  return document_t();
+}
+
+}  // namespace codec
+
+template<>
+struct default_codec_t<document> {
+  static codec::document_t codec() {
+    return codec::document();
+  }
+};
+
+}  // namespace json
+}  // namespace spotify
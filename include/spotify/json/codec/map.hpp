@@ -17,6 +17,9 @@
 #pragma once
 
 #include <map>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 
@@ -36,8 +39,10 @@ class map_t final {
   using object_type = T;
 
   static_assert(
-      std::is_same<typename T::key_type, std::string>::value,
-      "Map key type must be string");
+      std::is_same<typename T::key_type, std::string>::value ||
+      std::is_same<typename T::key_type, std::pmr::string>::value ||
+      std::is_same<typename T::key_type, std::string_view>::value,
+      "Map key type must be string, pmr::string or string_view");
   static_assert(
       std::is_convertible<
           typename T::mapped_type,
@@ -53,14 +58,19 @@ class map_t final {
   explicit map_t(const codec_type &inner_codec) : _inner_codec(inner_codec) {}
 
   object_type decode(decode_context &context) const {
+    auto output = detail::construct<object_type>(context);
+    decode_into(context, output);
+    return output;
+  }
+
+  void decode_into(decode_context &context, object_type &output) const {
     using value_type = typename object_type::value_type;
-    object_type output;
-    detail::decode_object<string_t>(
+    output.clear();
+    detail::decode_object<key_codec_type>(
         context,
-        [&](std::string &&key) {
+        [&](typename object_type::key_type &&key) {
           output.insert(value_type(std::move(key), _inner_codec.decode(context)));
         });
-    return output;
   }
 
   void encode(encode_context &context, const object_type &map) const {
@@ -77,7 +87,9 @@ class map_t final {
   }
 
  private:
-  string_t _string_codec;
+  using key_codec_type = decltype(default_codec<typename T::key_type>());
+
+  key_codec_type _string_codec;
   codec_type _inner_codec;
 };
 
@@ -102,5 +114,26 @@ struct default_codec_t<std::unordered_map<std::string, T>> {
   }
 };
 
+template <typename T>
+struct default_codec_t<std::pmr::unordered_map<std::pmr::string, T>> {
+  static decltype(codec::map<std::pmr::unordered_map<std::pmr::string, T>>(default_codec<T>())) codec() {
+    return codec::map<std::pmr::unordered_map<std::pmr::string, T>>(default_codec<T>());
+  }
+};
+
+template <typename T>
+struct default_codec_t<std::map<std::string_view, T>> {
+  static decltype(codec::map<std::map<std::string_view, T>>(default_codec<T>())) codec() {
+    return codec::map<std::map<std::string_view, T>>(default_codec<T>());
+  }
+};
+
+template <typename T>
+struct default_codec_t<std::unordered_map<std::string_view, T>> {
+  static decltype(codec::map<std::unordered_map<std::string_view, T>>(default_codec<T>())) codec() {
+    return codec::map<std::unordered_map<std::string_view, T>>(default_codec<T>());
+  }
+};
+
 }  // namespace json
 }  // namespace spotify
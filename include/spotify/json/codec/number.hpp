@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <type_traits>
 #include <double-conversion/double-conversion.h>
 #include <spotify/json/decode_context.hpp>
@@ -27,6 +28,7 @@
 #include <spotify/json/detail/encode_helpers.hpp>
 #include <spotify/json/detail/encode_integer.hpp>
 #include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/swar.hpp>
 #include <spotify/json/encode_context.hpp>
 
 namespace spotify {
@@ -84,6 +86,10 @@ struct integer_ops {
   static json_force_inline T accumulate(T old_value, T acc_value) {
     return (old_value + acc_value);
   }
+
+  static json_force_inline bool is_accumulate_overflow(T value, T digit) {
+    return (value > (std::numeric_limits<T>::max() - digit) / 10);
+  }
 };
 
 template <typename T>
@@ -95,6 +101,10 @@ struct integer_ops<T, false> {
   static json_force_inline T accumulate(T old_value, T acc_value) {
     return (old_value - acc_value);
   }
+
+  static json_force_inline bool is_accumulate_overflow(T value, T digit) {
+    return (value < (std::numeric_limits<T>::min() + digit) / 10);
+  }
 };
 
 template <typename T>
@@ -160,12 +170,11 @@ json_never_inline T decode_integer_range_with_overflow(
   for (auto it = begin; it != end; ++it) {
     const auto c = (*it);
     const auto i = to_integer<T>(c);
-    const auto old_value = value;
-    value = intops::accumulate(value * 10, i);
-    if (json_unlikely(intops::is_overflow(old_value, value))) {
+    if (json_unlikely(intops::is_accumulate_overflow(value, i))) {
       did_overflow = true;
-      return old_value;
+      return value;
     }
+    value = intops::accumulate(value * 10, i);
   }
 
   return value;
@@ -341,6 +350,24 @@ json_never_inline T decode_integer(decode_context &context) {
   fail_if(context, is_invalid_digit(i), "Invalid integer");
   T value = intops::accumulate(0, i);
 
+  // Consume the digits 8 at a time for as long as the value is guaranteed to
+  // fit the integer type, which is when it has no more than digits10 digits.
+  // The remaining digits, if any, are consumed one at a time below.
+  if constexpr (std::numeric_limits<T>::digits10 >= 9) {
+    constexpr auto max_safe_digits = std::numeric_limits<T>::digits10;
+    for (auto num_digits = 1; num_digits + 8 <= max_safe_digits; num_digits += 8) {
+      if (context.remaining() < 8) {
+        break;
+      }
+      const auto chunk = load_le_8(context.position);
+      if (!is_eight_digits(chunk)) {
+        break;
+      }
+      value = intops::accumulate(value * T(100000000), T(parse_eight_digits(chunk)));
+      skip_unchecked_n(context, 8);
+    }
+  }
+
   while (json_likely(context.remaining())) {
     const auto c = peek_unchecked(context);
     const auto i = to_integer<T>(c);
@@ -349,12 +376,11 @@ json_never_inline T decode_integer(decode_context &context) {
       return (json_unlikely(is_tricky) ? decode_integer_tricky<T, is_positive>(context, b) : value);
     }
 
-    skip_unchecked_1(context);
-    const auto old_value = value;
-    value = intops::accumulate(value * 10, i);
-    if (json_unlikely(intops::is_overflow(old_value, value))) {
+    if (json_unlikely(intops::is_accumulate_overflow(value, i))) {
       return decode_integer_tricky<T, is_positive>(context, b);
     }
+    skip_unchecked_1(context);
+    value = intops::accumulate(value * 10, i);
   }
 
   return value;
@@ -379,6 +405,8 @@ class integer_t<T, true, false> {
  public:
   using object_type = T;
 
+  static constexpr std::size_t max_encoded_size = std::numeric_limits<T>::digits10 + 1;
+
   json_force_inline object_type decode(decode_context &context) const {
     return decode_positive_integer<object_type>(context);
   }
@@ -393,6 +421,8 @@ class integer_t<T, true, true> {
  public:
   using object_type = T;
 
+  static constexpr std::size_t max_encoded_size = std::numeric_limits<T>::digits10 + 2;  // with '-'
+
   json_force_inline object_type decode(decode_context &context) const {
     return (peek(context) == '-' ?
         decode_negative_integer<object_type>(context) :
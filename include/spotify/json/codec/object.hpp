@@ -26,6 +26,8 @@
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/detail/bitset.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/encode_helpers.hpp>
 #include <spotify/json/detail/field_registry.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/detail/skip_value.hpp>
@@ -52,6 +54,18 @@ struct object_t_base {
   void decode(decode_context &context, void *value) const;
   void encode(encode_context &context, const void *value) const;
 
+  /**
+   * Decode into the fields of an existing object. Marks the fields that were
+   * decoded in seen_fields and returns how many there were.
+   */
+  size_t decode_into(decode_context &context, void *value, detail::bitset_base &seen_fields) const;
+
+  /**
+   * Reset the fields of value that are not in seen_fields to their values in
+   * prototype.
+   */
+  void reset_unseen(void *value, const void *prototype, const detail::bitset_base &seen_fields) const;
+
   detail::field_registry _fields;
 
   /**
@@ -101,6 +115,19 @@ class object_t final : public codec_detail::object_t_base {
     return value;
   }
 
+  /**
+   * Decode into an existing object. Fields in the input are decoded into the
+   * existing members, and fields that are not in the input are reset to their
+   * values in a newly constructed object.
+   */
+  void decode_into(decode_context &context, object_type &value) const {
+    detail::bitset<64> seen_fields(_fields.size());
+    if (object_t_base::decode_into(context, &value, seen_fields) != _fields.size()) {
+      const auto prototype = construct(std::is_default_constructible<T>());
+      object_t_base::reset_unseen(&value, &prototype, seen_fields);
+    }
+  }
+
   json_force_inline void encode(encode_context &context, const object_type &value) const {
     object_t_base::encode(context, &value);
   }
@@ -125,13 +152,16 @@ class object_t final : public codec_detail::object_t_base {
   template <typename codec_type>
   struct codec_field : public detail::field {
     codec_field(bool required, size_t required_field_idx, codec_type &&codec)
-        : field(required, required_field_idx),
+        : field(required, required_field_idx, always_encoded, max_encoded_size),
           codec(std::move(codec)) {}
 
     codec_field(bool required, size_t required_field_idx, const codec_type &codec)
-        : field(required, required_field_idx),
+        : field(required, required_field_idx, always_encoded, max_encoded_size),
           codec(codec) {}
 
+    static constexpr bool always_encoded = !detail::has_should_encode_method<codec_type>::value;
+    static constexpr size_t max_encoded_size = detail::max_encoded_size<codec_type>::value;
+
     template <typename value_type>
     void append_kv(encode_context &context, const std::string &key, const value_type &value) const {
       if (json_likely(detail::should_encode(this->codec, value))) {
@@ -156,9 +186,19 @@ class object_t final : public codec_detail::object_t_base {
       this->codec.decode(context);
     }
 
+    void decode_into(decode_context &context, void *) const override {
+      this->codec.decode(context);
+    }
+
+    void reset(void *, const void *) const override {}
+
     void encode(encode_context &context, const std::string &key, const void *) const override {
       this->append_kv(context, key, typename codec_type::object_type());
     }
+
+    void encode_value(encode_context &context, const void *) const override {
+      this->codec.encode(context, typename codec_type::object_type());
+    }
   };
 
   template <typename member_ptr, typename codec_type>
@@ -173,7 +213,17 @@ class object_t final : public codec_detail::object_t_base {
 
     void decode(decode_context &context, void *object) const override {
       auto &typed = *static_cast<object_type *>(object);
-      typed.*member = this->codec.decode(context);
+      detail::assign_decoded(typed.*member, this->codec.decode(context));
+    }
+
+    void decode_into(decode_context &context, void *object) const override {
+      auto &typed = *static_cast<object_type *>(object);
+      detail::decode_into(this->codec, context, typed.*member);
+    }
+
+    void reset(void *object, const void *prototype) const override {
+      auto &typed = *static_cast<object_type *>(object);
+      typed.*member = static_cast<const object_type *>(prototype)->*member;
     }
 
     void encode(encode_context &context, const std::string &key, const void *object) const override {
@@ -182,6 +232,11 @@ class object_t final : public codec_detail::object_t_base {
       this->append_kv(context, key, value);
     }
 
+    void encode_value(encode_context &context, const void *object) const override {
+      const auto &typed = *static_cast<const object_type *>(object);
+      this->codec.encode(context, typed.*member);
+    }
+
     member_ptr member;
   };
 
@@ -202,12 +257,26 @@ class object_t final : public codec_detail::object_t_base {
       (typed.*setter)(this->codec.decode(context));
     }
 
+    void decode_into(decode_context &context, void *object) const override {
+      decode(context, object);
+    }
+
+    void reset(void *object, const void *prototype) const override {
+      auto &typed = *static_cast<object_type *>(object);
+      (typed.*setter)((static_cast<const object_type *>(prototype)->*getter)());
+    }
+
     void encode(encode_context &context, const std::string &key, const void *object) const override {
       const auto &typed = *static_cast<const object_type *>(object);
       const auto &value = (typed.*getter)();
       this->append_kv(context, key, value);
     }
 
+    void encode_value(encode_context &context, const void *object) const override {
+      const auto &typed = *static_cast<const object_type *>(object);
+      this->codec.encode(context, (typed.*getter)());
+    }
+
     getter_ptr getter;
     setter_ptr setter;
   };
@@ -231,12 +300,26 @@ class object_t final : public codec_detail::object_t_base {
       set(typed, this->codec.decode(context));
     }
 
+    void decode_into(decode_context &context, void *object) const override {
+      decode(context, object);
+    }
+
+    void reset(void *object, const void *prototype) const override {
+      auto &typed = *static_cast<object_type *>(object);
+      set(typed, get(*static_cast<const object_type *>(prototype)));
+    }
+
     void encode(encode_context &context, const std::string &key, const void *object) const override {
       const auto &typed = *static_cast<const object_type *>(object);
       const auto &value = get(typed);
       this->append_kv(context, key, value);
     }
 
+    void encode_value(encode_context &context, const void *object) const override {
+      const auto &typed = *static_cast<const object_type *>(object);
+      this->codec.encode(context, get(typed));
+    }
+
     getter get;
     setter set;
   };
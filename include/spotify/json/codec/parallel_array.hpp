@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/parallel_for.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/split_records.hpp>
+#include <spotify/json/detail/structural_index.hpp>
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+
+struct parallel_array_options {
+  /**
+   * Arrays that are smaller than this many bytes are decoded on the calling
+   * thread, like with array_t.
+   */
+  size_t min_size = 1 << 20;
+
+  /**
+   * The number of threads to decode on, including the calling thread. 0 means
+   * one thread per hardware thread.
+   */
+  size_t num_threads = 0;
+};
+
+/**
+ * A codec for arrays that decodes large arrays on several threads. The elements
+ * of the array are split into slices in one pass over a structural index of the
+ * array, each slice is decoded into a vector of its own on a separate thread,
+ * and the slices are then moved into the output container.
+ *
+ * Decoding falls back to a serial array_t decode when the array is smaller than
+ * min_size or when the context has a memory_resource, since memory resources
+ * are not generally safe to allocate from concurrently.
+ */
+template <typename T, typename codec_type>
+class parallel_array_t final {
+ public:
+  using object_type = T;
+
+  parallel_array_t(codec_type &&inner_codec, const parallel_array_options &options)
+      : _inner_codec(std::move(inner_codec)),
+        _array(_inner_codec),
+        _options(options) {}
+  parallel_array_t(const codec_type &inner_codec, const parallel_array_options &options)
+      : _inner_codec(inner_codec),
+        _array(_inner_codec),
+        _options(options) {}
+
+  object_type decode(decode_context &context) const {
+    const auto num_threads = detail::resolve_num_threads(_options.num_threads);
+    if (json_likely(
+            context.remaining() < _options.min_size ||
+            num_threads == 1 ||
+            context.memory_resource ||
+            detail::peek(context) != '[')) {
+      return _array.decode(context);
+    }
+
+    // Arrays are only worth splitting when they are large, and their size is
+    // known only once their closing bracket is found in a structural index.
+    std::optional<detail::structural_index> local_index;
+    auto index = context.structural_index;
+    if (!index || context.position < index->begin() || context.position >= index->end()) {
+      index = &local_index.emplace(context.position, context.end, *context.kernels);
+    }
+    const auto close = index->find_matching_close(context.position);
+    if (!close || size_t(close - context.position) < _options.min_size) {
+      return _array.decode(context);
+    }
+
+    const auto slice_size = size_t(close - context.position) / (num_threads * 4) + 1;
+    decode_context split_context(context);
+    split_context.structural_index = index;
+    const auto slices = detail::split_array(split_context, slice_size);
+
+    std::vector<std::vector<element_type>> decoded(slices.size());
+    detail::parallel_for(slices.size(), num_threads, [&](const size_t i) {
+      decode_context slice_context(context.begin, slices[i].end);
+      slice_context.kernels = context.kernels;
+      slice_context.structural_index = index;
+      slice_context.position = slices[i].begin;
+      decoded[i] = decode_slice(slice_context);
+    });
+
+    context.position = split_context.position;
+    return concatenate(context, std::move(decoded));
+  }
+
+  void encode(encode_context &context, const object_type &array) const {
+    _array.encode(context, array);
+  }
+
+ private:
+  using element_type = typename std::decay<codec_type>::type::object_type;
+
+  std::vector<element_type> decode_slice(decode_context &context) const {
+    std::vector<element_type> elements;
+    while (true) {
+      elements.push_back(_inner_codec.decode(context));
+      detail::skip_any_whitespace(context);
+      if (!context.remaining()) {
+        return elements;
+      }
+      detail::skip_1(context, ',');
+      detail::skip_any_whitespace(context);
+    }
+  }
+
+  object_type concatenate(
+      decode_context &context,
+      std::vector<std::vector<element_type>> &&slices) const {
+    if constexpr (std::is_same<object_type, std::vector<element_type>>::value) {
+      if (!slices.empty()) {
+        auto output = std::move(slices.front());
+        auto size = output.size();
+        for (size_t i = 1; i < slices.size(); i++) {
+          size += slices[i].size();
+        }
+        output.reserve(size);
+        for (size_t i = 1; i < slices.size(); i++) {
+          std::move(slices[i].begin(), slices[i].end(), std::back_inserter(output));
+        }
+        return output;
+      }
+    }
+
+    using inserter = detail::container_inserter<T>;
+    auto output = detail::construct<object_type>(context);
+    typename inserter::state state = inserter::init_state;
+    for (auto &slice : slices) {
+      for (auto &element : slice) {
+        state = inserter::insert(context, state, output, std::move(element));
+      }
+    }
+    inserter::validate(context, state, output);
+    return output;
+  }
+
+  codec_type _inner_codec;
+  array_t<T, codec_type> _array;
+  parallel_array_options _options;
+};
+
+template <typename T, typename codec_type>
+parallel_array_t<T, typename std::decay<codec_type>::type> parallel_array(
+    codec_type &&inner_codec,
+    const parallel_array_options &options = parallel_array_options()) {
+  return parallel_array_t<T, typename std::decay<codec_type>::type>(
+      std::forward<codec_type>(inner_codec), options);
+}
+
+}  // namespace codec
+}  // namespace json
+}  // namespace spotify
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <memory>
+#include <memory_resource>
 #include <utility>
 
 #include <spotify/json/decode_context.hpp>
@@ -46,6 +48,21 @@ struct make_smart_ptr_t<std::shared_ptr<T>> {
     using object_type = typename std::decay<Obj>::type;
     return std::make_shared<object_type>(std::forward<Obj>(obj));
   }
+
+  /**
+   * Allocate the object and the control block from the memory resource of the
+   * context, if it has one.
+   */
+  template <typename Obj>
+  static std::shared_ptr<T> make(const decode_context &context, Obj &&obj) {
+    using object_type = typename std::decay<Obj>::type;
+    if (context.memory_resource) {
+      const auto allocator = std::pmr::polymorphic_allocator<object_type>(context.memory_resource);
+      return std::allocate_shared<object_type>(allocator, std::forward<Obj>(obj));
+    } else {
+      return make(std::forward<Obj>(obj));
+    }
+  }
 };
 
 }  // namespace codec
@@ -61,7 +78,12 @@ class smart_ptr_t final {
   explicit smart_ptr_t(const codec_type &inner_codec) : _inner_codec(inner_codec) {}
 
   object_type decode(decode_context &context) const {
-    return codec::make_smart_ptr_t<object_type>::make(_inner_codec.decode(context));
+    using make_type = codec::make_smart_ptr_t<object_type>;
+    if constexpr (can_make_with_context<make_type>::value) {
+      return make_type::make(context, _inner_codec.decode(context));
+    } else {
+      return make_type::make(_inner_codec.decode(context));
+    }
   }
 
   void encode(encode_context &context, const object_type &value) const {
@@ -74,6 +96,14 @@ class smart_ptr_t final {
   }
 
  protected:
+  template <typename make_type, typename = void>
+  struct can_make_with_context : std::false_type {};
+
+  template <typename make_type>
+  struct can_make_with_context<make_type, decltype(void(make_type::make(
+      std::declval<const decode_context &>(),
+      std::declval<typename codec_type::object_type>())))> : std::true_type {};
+
   codec_type _inner_codec;
 };
 
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/encode_helpers.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+namespace codec_detail {
+
+/**
+ * An object key, stored both as is and escaped with the surrounding quotes and
+ * the trailing ':', exactly like detail::write_escaped would write it. The
+ * escaping is done by a constexpr constructor, so it happens at compile time
+ * for codecs that are constructed in a constant expression.
+ */
+template <std::size_t size>
+struct static_key final {
+  constexpr static_key(const char (&name)[size])
+      : name(name),
+        escaped(),
+        escaped_size(0) {
+    escaped[escaped_size++] = '"';
+    for (std::size_t i = 0; i + 1 < size; i++) {
+      append_escaped(name[i]);
+    }
+    escaped[escaped_size++] = '"';
+    escaped[escaped_size++] = ':';
+  }
+
+  /**
+   * Check if the key at context.position is this key. The quotes make the
+   * escaped key self-delimiting, so a byte-wise match of everything but the
+   * ':' is a match of the key. On a match, context.position is moved past it.
+   */
+  json_force_inline bool match_escaped(decode_context &context) const {
+    const auto quoted_size = escaped_size - 1;  // do not include the ':'
+    if (context.remaining() >= quoted_size &&
+        std::memcmp(context.position, escaped, quoted_size) == 0) {
+      context.position += quoted_size;
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  json_force_inline bool match(const char *key, const std::size_t key_size) const {
+    return (key_size == size - 1) && (std::memcmp(key, name, key_size) == 0);
+  }
+
+  const char *name;
+  char escaped[6 * (size - 1) + 3];  // 6 is the length of \u00xx
+  std::size_t escaped_size;
+
+ private:
+  constexpr void append_escaped(const char c) {
+    const char hex[] = "0123456789ABCDEF";
+    switch (c) {
+      case '"': append_2('\\', '"'); break;
+      case '\\': append_2('\\', '\\'); break;
+      case '\b': append_2('\\', 'b'); break;
+      case '\f': append_2('\\', 'f'); break;
+      case '\n': append_2('\\', 'n'); break;
+      case '\r': append_2('\\', 'r'); break;
+      case '\t': append_2('\\', 't'); break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          append_2('\\', 'u');
+          append_2('0', '0');
+          append_2(hex[(c >> 4) & 0xF], hex[c & 0xF]);
+        } else {
+          escaped[escaped_size++] = c;
+        }
+    }
+  }
+
+  constexpr void append_2(const char a, const char b) {
+    escaped[escaped_size++] = a;
+    escaped[escaped_size++] = b;
+  }
+};
+
+template <bool is_required, std::size_t key_size, typename member_ptr, typename codec_type>
+struct static_field final {
+  static constexpr bool required = is_required;
+
+  constexpr static_field(const char (&name)[key_size], member_ptr member, codec_type codec)
+      : key(name),
+        member(member),
+        codec(std::move(codec)) {}
+
+  static_key<key_size> key;
+  member_ptr member;
+  codec_type codec;
+};
+
+}  // namespace codec_detail
+
+/**
+ * An object codec with a field list that is fixed at compile time. Unlike
+ * object_t, which stores its fields behind shared pointers and calls them
+ * virtually, the fields of a static_object_t are stored in a tuple and visited
+ * with fold expressions, so that the field codecs can be inlined into the
+ * decode and encode functions of the object.
+ *
+ * Fields are added with required_field and optional_field, and refer to member
+ * variables of T, which must be default constructible.
+ */
+template <typename T, typename... field_types>
+class static_object_t final {
+ public:
+  using object_type = T;
+
+  static_assert(
+      std::is_default_constructible<T>::value,
+      "static_object_t requires a default constructible object type");
+
+  constexpr explicit static_object_t(field_types... fields)
+      : _fields(std::move(fields)...) {}
+
+  object_type decode(decode_context &context) const {
+    object_type value = object_type();
+    decode_fields<false>(context, value);
+    return value;
+  }
+
+  /**
+   * Decode into an existing object. Fields in the input are decoded into the
+   * existing members, and fields that are not in the input are reset to their
+   * values in a newly constructed object.
+   */
+  void decode_into(decode_context &context, object_type &value) const {
+    const auto seen = decode_fields<true>(context, value);
+    if (!seen.all()) {
+      const object_type prototype = object_type();
+      reset_unseen_fields(value, prototype, seen, indices());
+    }
+  }
+
+  void encode(encode_context &context, const object_type &value) const {
+    context.append('{');
+    encode_fields(context, value, indices());
+    context.append_or_replace(',', '}');
+  }
+
+ private:
+  static constexpr std::size_t num_fields = sizeof...(field_types);
+  using indices = std::make_index_sequence<num_fields>;
+
+  /**
+   * Decode the value of field i. When decoding into an existing object, the
+   * value is decoded into the member so that the memory it owns is reused.
+   * Otherwise it is decoded on its own and assigned, so that members that use
+   * a polymorphic allocator keep the memory resource of the context.
+   */
+  template <bool into, std::size_t i>
+  json_force_inline void decode_value(
+      decode_context &context,
+      object_type &value,
+      std::bitset<num_fields> &seen,
+      std::size_t &next_index) const {
+    const auto &field = std::get<i>(_fields);
+    if constexpr (into) {
+      detail::decode_into(field.codec, context, value.*field.member);
+    } else {
+      detail::assign_decoded(value.*field.member, field.codec.decode(context));
+    }
+    seen.set(i);
+    next_index = i + 1;
+  }
+
+  json_force_inline static void skip_colon(decode_context &context) {
+    detail::skip_any_whitespace(context);
+    detail::skip_1(context, ':');
+    detail::skip_any_whitespace(context);
+  }
+
+  template <bool into, std::size_t i>
+  json_force_inline bool decode_if_escaped_key_matches(
+      decode_context &context,
+      object_type &value,
+      std::bitset<num_fields> &seen,
+      std::size_t &next_index) const {
+    if (!std::get<i>(_fields).key.match_escaped(context)) {
+      return false;
+    }
+
+    skip_colon(context);
+    decode_value<into, i>(context, value, seen, next_index);
+    return true;
+  }
+
+  template <bool into, std::size_t i>
+  json_force_inline bool decode_if_key_matches(
+      decode_context &context,
+      const char *key,
+      const std::size_t key_size,
+      object_type &value,
+      std::bitset<num_fields> &seen,
+      std::size_t &next_index) const {
+    if (!std::get<i>(_fields).key.match(key, key_size)) {
+      return false;
+    }
+
+    decode_value<into, i>(context, value, seen, next_index);
+    return true;
+  }
+
+  template <bool into, std::size_t... i>
+  json_force_inline void decode_field(
+      decode_context &context,
+      object_type &value,
+      std::bitset<num_fields> &seen,
+      std::size_t &next_index,
+      std::index_sequence<i...>) const {
+    // Producers almost always write the fields in the order that they are
+    // declared in, so first guess that this is the field after the previous.
+    if (((i == next_index && decode_if_escaped_key_matches<into, i>(context, value, seen, next_index)) || ...) ||
+        (decode_if_escaped_key_matches<into, i>(context, value, seen, next_index) || ...)) {
+      return;
+    }
+
+    // The key is either not a field, or it is escaped differently than the
+    // escaped keys of the fields.
+    detail::skip_1(context, '"');
+    const auto key_begin = context.position;
+    detail::skip_any_simple_characters(context);
+    if (json_likely(detail::next(context, "Unterminated string") == '"')) {
+      const auto key_size = std::size_t(context.position - 1 - key_begin);
+      skip_colon(context);
+      if (!(decode_if_key_matches<into, i>(context, key_begin, key_size, value, seen, next_index) || ...)) {
+        detail::skip_value(context);
+      }
+    } else {
+      context.position = key_begin - 1;
+      const auto key = string_t().decode(context);
+      skip_colon(context);
+      if (!(decode_if_key_matches<into, i>(context, key.data(), key.size(), value, seen, next_index) || ...)) {
+        detail::skip_value(context);
+      }
+    }
+  }
+
+  template <bool into>
+  json_force_inline std::bitset<num_fields> decode_fields(
+      decode_context &context,
+      object_type &value) const {
+    std::bitset<num_fields> seen;
+    std::size_t next_index = 0;
+
+    detail::decode_comma_separated(context, '{', '}', [&]{
+      decode_field<into>(context, value, seen, next_index, indices());
+    });
+
+    detail::fail_if(context, !has_required_fields(seen, indices()), "Missing required field(s)");
+    return seen;
+  }
+
+  template <std::size_t i>
+  json_force_inline void reset_field_if_unseen(
+      object_type &value,
+      const object_type &prototype,
+      const std::bitset<num_fields> &seen) const {
+    if (!seen.test(i)) {
+      const auto &field = std::get<i>(_fields);
+      value.*field.member = prototype.*field.member;
+    }
+  }
+
+  template <std::size_t... i>
+  json_force_inline void reset_unseen_fields(
+      object_type &value,
+      const object_type &prototype,
+      const std::bitset<num_fields> &seen,
+      std::index_sequence<i...>) const {
+    (reset_field_if_unseen<i>(value, prototype, seen), ...);
+  }
+
+  template <std::size_t... i>
+  json_force_inline static bool has_required_fields(
+      const std::bitset<num_fields> &seen,
+      std::index_sequence<i...>) {
+    return ((!field_types::required || seen.test(i)) && ...);
+  }
+
+  template <std::size_t i>
+  json_force_inline void encode_field(encode_context &context, const object_type &value) const {
+    const auto &field = std::get<i>(_fields);
+    const auto &field_value = value.*field.member;
+    if (json_likely(detail::should_encode(field.codec, field_value))) {
+      context.append(field.key.escaped, field.key.escaped_size);
+      field.codec.encode(context, field_value);
+      context.append(',');
+    }
+  }
+
+  template <std::size_t... i>
+  json_force_inline void encode_fields(
+      encode_context &context,
+      const object_type &value,
+      std::index_sequence<i...>) const {
+    (encode_field<i>(context, value), ...);
+  }
+
+  std::tuple<field_types...> _fields;
+};
+
+template <std::size_t key_size, typename value_type, typename object_type, typename codec_type>
+constexpr codec_detail::static_field<true, key_size, value_type object_type::*, typename std::decay<codec_type>::type>
+required_field(const char (&name)[key_size], value_type object_type::*member, codec_type &&codec) {
+  return { name, member, std::forward<codec_type>(codec) };
+}
+
+template <std::size_t key_size, typename value_type, typename object_type>
+auto required_field(const char (&name)[key_size], value_type object_type::*member)
+    -> decltype(required_field(name, member, default_codec<value_type>())) {
+  return required_field(name, member, default_codec<value_type>());
+}
+
+template <std::size_t key_size, typename value_type, typename object_type, typename codec_type>
+constexpr codec_detail::static_field<false, key_size, value_type object_type::*, typename std::decay<codec_type>::type>
+optional_field(const char (&name)[key_size], value_type object_type::*member, codec_type &&codec) {
+  return { name, member, std::forward<codec_type>(codec) };
+}
+
+template <std::size_t key_size, typename value_type, typename object_type>
+auto optional_field(const char (&name)[key_size], value_type object_type::*member)
+    -> decltype(optional_field(name, member, default_codec<value_type>())) {
+  return optional_field(name, member, default_codec<value_type>());
+}
+
+template <typename T, typename... field_types>
+constexpr static_object_t<T, typename std::decay<field_types>::type...> static_object(
+    field_types &&...fields) {
+  return static_object_t<T, typename std::decay<field_types>::type...>(
+      std::forward<field_types>(fields)...);
+}
+
+}  // namespace codec
+}  // namespace json
+}  // namespace spotify
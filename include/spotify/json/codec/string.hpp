@@ -17,6 +17,10 @@
 #pragma once
 
 #include <algorithm>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/encode_context.hpp>
@@ -30,6 +34,7 @@ class string_t final {
   using object_type = std::string;
 
   object_type decode(decode_context &context) const;
+  void decode_into(decode_context &context, object_type &value) const;
   void encode(encode_context &context, const object_type value) const;
 };
 
@@ -37,6 +42,43 @@ inline string_t string() {
   return string_t();
 }
 
+/**
+ * A codec for std::pmr::string. Decoded strings allocate from
+ * decode_context::memory_resource when it is set, and from the default memory
+ * resource otherwise.
+ */
+class pmr_string_t final {
+ public:
+  using object_type = std::pmr::string;
+
+  object_type decode(decode_context &context) const;
+  void decode_into(decode_context &context, object_type &value) const;
+  void encode(encode_context &context, const object_type &value) const;
+};
+
+inline pmr_string_t pmr_string() {
+  return pmr_string_t();
+}
+
+/**
+ * A string codec that decodes without copying: strings without escape
+ * sequences point straight into the input buffer, so the decoded values are
+ * only valid for as long as the input is. Strings with escape sequences are
+ * unescaped into decode_context::memory_resource, and decoding fails if none
+ * is set.
+ */
+class string_view_t final {
+ public:
+  using object_type = std::string_view;
+
+  object_type decode(decode_context &context) const;
+  void encode(encode_context &context, const object_type value) const;
+};
+
+inline string_view_t string_view() {
+  return string_view_t();
+}
+
 }  // namespace codec
 
 template <>
@@ -46,5 +88,19 @@ struct default_codec_t<std::string> {
   }
 };
 
+template <>
+struct default_codec_t<std::pmr::string> {
+  static codec::pmr_string_t codec() {
+    return codec::pmr_string_t();
+  }
+};
+
+template <>
+struct default_codec_t<std::string_view> {
+  static codec::string_view_t codec() {
+    return codec::string_view_t();
+  }
+};
+
 }  // namespace json
 }  // namespace spotify
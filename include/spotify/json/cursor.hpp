@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/encoded_value.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A cursor is a position in a JSON value that is read on demand: looking up a
+ * member or an element reads the keys of the object, or counts the elements
+ * of the array, up to the one that was asked for and skips the values on the
+ * way with the fast skipper. Nothing is decoded until get is called, and only
+ * the value that the cursor points to is decoded then. No tree is built, so a
+ * handler that reads a few fields out of a large body only pays for the bytes
+ * up to and including those fields.
+ *
+ *   const auto id = cursor(body)["user"]["id"].get<int64_t>();
+ *
+ * A cursor is a few pointers into the input, which must outlive it. An object
+ * cursor remembers the member that it found last, and the next lookup starts
+ * reading after it, wrapping around to the first member if the key is not
+ * found after it. Members that are looked up in the order that they appear
+ * in the input are thereby found in a single pass over the object. Because of
+ * this, a cursor must not be shared between threads, and when an object has
+ * several members with the same key it is unspecified which one is found.
+ *
+ * Only the parts of the input that are read are validated. Errors, such as a
+ * missing member or a value of the wrong type, throw decode_exception with an
+ * offset from the beginning of the input.
+ */
+class cursor final {
+ public:
+  cursor(const char *data, size_t size);
+  explicit cursor(const encoded_value_ref &json);
+
+  /**
+   * The value of a member of this object with key. Throws
+   * decode_exception if this is not an object or has no such member.
+   */
+  cursor operator[](std::string_view key) const;
+
+  /**
+   * The element at index of this array. Throws decode_exception if this is
+   * not an array or the array is too short.
+   */
+  cursor operator[](size_t index) const;
+
+  /**
+   * Like operator[](std::string_view), but returns nothing instead of
+   * throwing when the object has no member with key.
+   */
+  std::optional<cursor> find(std::string_view key) const;
+
+  /**
+   * The value that a JSON Pointer (RFC 6901) such as "/tracks/0/uri" refers
+   * to, relative to this value.
+   *
+   * @throws std::invalid_argument if the pointer is malformed.
+   * @throws decode_exception if there is no such value.
+   */
+  cursor at_pointer(std::string_view pointer) const;
+
+  /**
+   * Decode the value of the cursor with a codec, or with the default codec
+   * of value_type.
+   */
+  template <typename codec_type>
+  typename codec_type::object_type get(const codec_type &codec) const {
+    auto context = this->context();
+    return codec.decode(context);
+  }
+
+  template <typename value_type>
+  value_type get() const {
+    return get(default_codec<value_type>());
+  }
+
+  bool is_null() const;
+
+  /**
+   * The text of the value of the cursor, which is skipped (and thereby
+   * validated) to find its end.
+   */
+  encoded_value_ref json() const;
+
+  /**
+   * The offset of the value of the cursor from the beginning of the input.
+   */
+  size_t offset() const { return size_t(_position - _begin); }
+
+ private:
+  cursor(const cursor &parent, const char *position);
+
+  decode_context context() const;
+
+  const char *_begin;
+  const char *_end;
+  const char *_position;
+  mutable const char *_last_member;
+};
+
+}  // namespace json
+}  // namespace spotify
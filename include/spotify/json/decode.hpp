@@ -22,6 +22,7 @@
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/structural_index.hpp>
 
 namespace spotify {
 namespace json {
@@ -34,7 +35,7 @@ template <typename codec_type>
 typename codec_type::object_type decode(const codec_type &codec, const char *data, size_t size) {
   decode_context c(data, data + size);
   detail::skip_any_whitespace(c);
-  const auto result = codec.decode(c);
+  auto result = codec.decode(c);
   detail::skip_any_whitespace(c);
   detail::fail_if(c, c.position != c.end, "Unexpected trailing input");
   return result;
@@ -69,6 +70,82 @@ value_type decode(const string_type &string) {
   return decode(default_codec<value_type>(), string);
 }
 
+/*
+ * json::decode_indexed(codec, data...)
+ *
+ * Like json::decode, but builds a structural index of the input first, so that
+ * arrays and objects that are skipped (such as the values of unknown object
+ * fields) are jumped over instead of parsed. Skipped values are then only
+ * checked for balanced brackets and terminated strings.
+ */
+
+template <typename codec_type>
+typename codec_type::object_type decode_indexed(const codec_type &codec, const char *data, size_t size) {
+  const detail::structural_index index(data, data + size);
+  decode_context c(data, data + size);
+  c.structural_index = &index;
+  detail::skip_any_whitespace(c);
+  auto result = codec.decode(c);
+  detail::skip_any_whitespace(c);
+  detail::fail_if(c, c.position != c.end, "Unexpected trailing input");
+  return result;
+}
+
+template <typename codec_type, typename string_type>
+typename codec_type::object_type decode_indexed(const codec_type &codec, const string_type &string) {
+  return decode_indexed(codec, string.data(), string.size());
+}
+
+template <typename value_type>
+value_type decode_indexed(const char *data, size_t size) {
+  return decode_indexed(default_codec<value_type>(), data, size);
+}
+
+template <typename value_type, typename string_type>
+value_type decode_indexed(const string_type &string) {
+  return decode_indexed(default_codec<value_type>(), string);
+}
+
+/*
+ * json::decode_into(codec, data..., &object)
+ *
+ * Like json::decode, but decodes into an existing object. Codecs that support
+ * it decode straight into the object's members, so that strings and containers
+ * keep the memory that they already own. If decoding fails, the object is left
+ * in a valid but unspecified state.
+ */
+
+template <typename codec_type>
+void decode_into(
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    typename codec_type::object_type &object) {
+  decode_context c(data, data + size);
+  detail::skip_any_whitespace(c);
+  detail::decode_into(codec, c, object);
+  detail::skip_any_whitespace(c);
+  detail::fail_if(c, c.position != c.end, "Unexpected trailing input");
+}
+
+template <typename codec_type, typename string_type>
+void decode_into(
+    const codec_type &codec,
+    const string_type &string,
+    typename codec_type::object_type &object) {
+  decode_into(codec, string.data(), string.size(), object);
+}
+
+template <typename value_type>
+void decode_into(const char *data, size_t size, value_type &object) {
+  decode_into(default_codec<value_type>(), data, size, object);
+}
+
+template <typename value_type, typename string_type>
+void decode_into(const string_type &string, value_type &object) {
+  decode_into(default_codec<value_type>(), string.data(), string.size(), object);
+}
+
 /*
  * json::try_decode(&object, codec, data...)
  */
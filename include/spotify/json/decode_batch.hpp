@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * The error of one record of a batch that could not be decoded.
+ */
+struct decode_batch_error {
+  size_t index;  // the index of the record in the batch
+  size_t offset;  // the offset of the error in the record
+  std::string message;
+};
+
+struct decode_batch_options {
+  /**
+   * Prefetch the beginning of the next record while decoding a record, which
+   * helps when the records are scattered in memory, such as in the buffers of
+   * a message queue consumer.
+   */
+  bool prefetch = true;
+
+  /**
+   * The number of bytes at the beginning of the next record to prefetch.
+   */
+  size_t prefetch_size = 256;
+};
+
+namespace detail {
+
+template <typename record_type>
+json_force_inline void prefetch_record(const record_type &record, const size_t max_size) {
+  const auto data = record.data();
+  const auto size = std::min<size_t>(record.size(), max_size);
+  for (size_t offset = 0; offset < size; offset += 64) {
+    json_prefetch(data + offset);
+  }
+}
+
+}  // namespace detail
+
+/*
+ * json::decode_batch(codec, first, last, out)
+ *
+ * Decode a batch of independent records, such as the messages of a message
+ * queue, with the same codec. Each record is anything with data() and size()
+ * (like std::string or std::string_view) and must hold exactly one value, like
+ * for json::decode. The decoded values of the records are written to out in
+ * order. Records that fail to decode are skipped; instead of throwing, their
+ * errors are returned, in order. Apart from prefetching the next record while
+ * decoding one, this is the same as calling decode for each record.
+ *
+ * Empty and whitespace-only records, and trailing input after a value, are
+ * detected without throwing. Any other error is thrown by the codec and caught
+ * here, so such a record costs one decode_exception.
+ */
+
+template <typename codec_type, typename forward_iterator, typename output_iterator>
+std::vector<decode_batch_error> decode_batch(
+    const codec_type &codec,
+    const forward_iterator first,
+    const forward_iterator last,
+    output_iterator out,
+    const decode_batch_options &options = decode_batch_options()) {
+  std::vector<decode_batch_error> errors;
+
+  size_t index = 0;
+  for (auto it = first; it != last; ++it, ++index) {
+    if (options.prefetch) {
+      const auto next = std::next(it);
+      if (next != last) {
+        detail::prefetch_record(*next, options.prefetch_size);
+      }
+    }
+
+    const auto data = it->data();
+    decode_context context(data, data + it->size());
+    detail::skip_any_whitespace(context);
+    if (json_unlikely(context.position == context.end)) {
+      errors.push_back(decode_batch_error{ index, context.offset(), "Unexpected end of input" });
+      continue;
+    }
+
+    try {
+      auto value = codec.decode(context);
+      detail::skip_any_whitespace(context);
+      if (json_likely(context.position == context.end)) {
+        *out = std::move(value);
+        ++out;
+      } else {
+        errors.push_back(decode_batch_error{ index, context.offset(), "Unexpected trailing input" });
+      }
+    } catch (const decode_exception &exception) {
+      errors.push_back(decode_batch_error{ index, exception.offset(), exception.what() });
+    }
+  }
+
+  return errors;
+}
+
+template <typename codec_type, typename records_type, typename output_iterator>
+std::vector<decode_batch_error> decode_batch(
+    const codec_type &codec,
+    const records_type &records,
+    output_iterator out,
+    const decode_batch_options &options = decode_batch_options()) {
+  return decode_batch(codec, std::begin(records), std::end(records), out, options);
+}
+
+template <typename value_type, typename records_type, typename output_iterator>
+std::vector<decode_batch_error> decode_batch(
+    const records_type &records,
+    output_iterator out,
+    const decode_batch_options &options = decode_batch_options()) {
+  return decode_batch(default_codec<value_type>(), std::begin(records), std::end(records), out, options);
+}
+
+}  // namespace json
+}  // namespace spotify
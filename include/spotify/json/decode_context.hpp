@@ -17,12 +17,16 @@
 #pragma once
 
 #include <cstddef>
+#include <memory_resource>
 #include <spotify/json/decode_exception.hpp>
-#include <spotify/json/detail/cpuid.hpp>
+#include <spotify/json/detail/kernels.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 namespace spotify {
 namespace json {
+namespace detail {
+class structural_index;
+}  // namespace detail
 
 /**
  * A decode_context has the information that is kept while decoding JSON with
@@ -45,7 +49,30 @@ struct decode_context final {
     return (end - position);
   }
 
-  const bool has_sse42;
+  /**
+   * Whether the kernels of this context use SSE 4.2 or wider instructions.
+   * This used to be a data member; it is now derived from the kernel table.
+   */
+  json_force_inline bool has_sse42() const {
+    return (kernels->tier >= detail::kernel_tier::sse42);
+  }
+
+  const detail::kernel_table *kernels;
+
+  /**
+   * An optional structural index of the buffer being decoded. When set,
+   * skip_value jumps over arrays and objects using the index instead of
+   * parsing them. See detail/structural_index.hpp.
+   */
+  const detail::structural_index *structural_index;
+
+  /**
+   * An optional arena for decoded values. std::pmr containers and strings,
+   * shared_ptr values and the unescaped contents of string_view values are
+   * allocated from it. The memory resource must outlive the decoded values.
+   */
+  std::pmr::memory_resource *memory_resource;
+
   const char *position;
   const char *const begin;
   const char *const end;
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <string>
+
+#include <spotify/json/decode.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/mapped_file.hpp>
+
+namespace spotify {
+namespace json {
+
+/*
+ * json::decode_file(codec, path, options)
+ *
+ * Decode the JSON in a file, like json::decode, directly from a read-only
+ * memory mapping of the file instead of from a copy of it on the heap. The
+ * mapping is unmapped when decode_file returns, so the codec must not return
+ * values that point into the input, such as those of string_view_t.
+ *
+ * @throws std::system_error if the file can not be opened or mapped.
+ * @throws decode_exception if the JSON can not be decoded.
+ */
+
+template <typename codec_type>
+typename codec_type::object_type decode_file(
+    const codec_type &codec,
+    const std::string &path,
+    const mapped_file_options &options = mapped_file_options()) {
+  const mapped_file file(path, options);
+  return decode(codec, file.data(), file.size());
+}
+
+template <typename value_type>
+value_type decode_file(
+    const std::string &path,
+    const mapped_file_options &options = mapped_file_options()) {
+  return decode_file(default_codec<value_type>(), path, options);
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/parallel_for.hpp>
+#include <spotify/json/detail/split_records.hpp>
+
+namespace spotify {
+namespace json {
+
+struct decode_stream_options {
+  /**
+   * The number of threads to decode on, including the calling thread. 0 means
+   * one thread per hardware thread.
+   */
+  size_t num_threads = 0;
+
+  /**
+   * The number of records that a thread decodes before it takes more work.
+   */
+  size_t batch_size = 64;
+};
+
+namespace detail {
+
+template <typename codec_type, typename callback_type>
+void decode_records(
+    const codec_type &codec,
+    const char *data,
+    const std::vector<record> &records,
+    const decode_stream_options &options,
+    const callback_type &callback) {
+  const auto batch_size = std::max<size_t>(options.batch_size, 1);
+  const auto num_batches = (records.size() + batch_size - 1) / batch_size;
+  parallel_for(num_batches, options.num_threads, [&](const size_t batch) {
+    const auto batch_end = std::min(records.size(), (batch + 1) * batch_size);
+    for (auto i = batch * batch_size; i < batch_end; i++) {
+      const auto &record = records[i];
+      decode_context context(record.begin, record.end);
+      try {
+        auto value = codec.decode(context);
+        skip_any_whitespace(context);
+        fail_if(context, context.position != context.end, "Unexpected trailing input");
+        callback(i, std::move(value));
+      } catch (decode_exception &exception) {
+        const auto offset = size_t(record.begin - data) + exception.offset();
+        throw decode_exception(std::move(exception), offset);
+      }
+    }
+  });
+}
+
+}  // namespace detail
+
+/*
+ * json::decode_stream(codec, data..., callback)
+ *
+ * Decode all JSON values in a buffer of newline delimited (NDJSON) or
+ * concatenated JSON in parallel. The values are split in one pass over the
+ * buffer, and then decoded by a pool of threads. callback(index, value) is
+ * called for each decoded value on the thread that decoded it, so it may be
+ * called concurrently and out of order. If a value fails to decode, the
+ * decode_exception of the first failing value is rethrown, with its offset
+ * from the beginning of the buffer.
+ */
+
+template <
+    typename codec_type,
+    typename callback_type,
+    typename = typename std::enable_if<!std::is_same<
+        typename std::decay<callback_type>::type,
+        decode_stream_options>::value>::type>
+void decode_stream(
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    const callback_type &callback,
+    const decode_stream_options &options = decode_stream_options()) {
+  const auto records = detail::split_records(data, data + size, detail::default_kernel_table());
+  detail::decode_records(codec, data, records, options, callback);
+}
+
+/*
+ * json::decode_stream(codec, data...)
+ *
+ * Like decode_stream with a callback, but returns the decoded values in the
+ * order of the buffer.
+ */
+
+template <typename codec_type>
+std::vector<typename codec_type::object_type> decode_stream(
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    const decode_stream_options &options = decode_stream_options()) {
+  using object_type = typename codec_type::object_type;
+  const auto records = detail::split_records(data, data + size, detail::default_kernel_table());
+
+  std::vector<std::optional<object_type>> decoded(records.size());
+  detail::decode_records(codec, data, records, options, [&](const size_t i, object_type &&value) {
+    decoded[i].emplace(std::move(value));
+  });
+
+  std::vector<object_type> values;
+  values.reserve(decoded.size());
+  for (auto &value : decoded) {
+    values.push_back(std::move(*value));
+  }
+  return values;
+}
+
+template <typename codec_type, typename string_type>
+std::vector<typename codec_type::object_type> decode_stream(
+    const codec_type &codec,
+    const string_type &string,
+    const decode_stream_options &options = decode_stream_options()) {
+  return decode_stream(codec, string.data(), string.size(), options);
+}
+
+template <typename value_type, typename string_type>
+std::vector<value_type> decode_stream(
+    const string_type &string,
+    const decode_stream_options &options = decode_stream_options()) {
+  return decode_stream(default_codec<value_type>(), string.data(), string.size(), options);
+}
+
+}  // namespace json
+}  // namespace spotify
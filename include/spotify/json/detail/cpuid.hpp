@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2016 Spotify AB
+ * Copyright (c) 2015-2019 Spotify AB
  *
  * Licensed under the Apache License, Version 2.0 (the "License"); you may not
  * use this file except in compliance with the License. You may obtain a copy of
@@ -20,6 +20,7 @@
 #include <cstdint>
 
 #if defined(_MSC_VER)
+#include <immintrin.h>
 #include <intrin.h>
 #endif
 
@@ -33,24 +34,48 @@ class cpuid {
  public:
   cpuid() {
 #if defined(json_arch_x86)
-    const uint32_t cpuid_function(1);
-#if defined(_MSC_VER)
-    ::__cpuid(reinterpret_cast<int *>(_registers.data()), cpuid_function);
-#elif defined(__GNUC__)
-    __asm__ __volatile__ (
-        "cpuid ;\n"
-        : "=a" (_registers[cpu_register::eax]),
-          "=b" (_registers[cpu_register::ebx]),
-          "=c" (_registers[cpu_register::ecx]),
-          "=d" (_registers[cpu_register::edx])
-        : "a" (cpuid_function)
-        :);
-#endif  // defined(_MSC_VER)
+    query(1, _registers);
+    if (has_os_avx_support()) {
+      _xcr0 = read_xcr0();
+    }
+
+    std::array<uint32_t, 4> max_function;
+    query(0, max_function);
+    if (max_function[cpu_register::eax] >= 7) {
+      query(7, _extended_registers);
+    }
 #endif  // defined(json_arch_x86)
   }
 
   bool has_sse42() const {
-    return has_feature_bit(cpu_register::ecx, cpu_feature_bit::sse_42);
+    return has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::sse_42);
+  }
+
+  bool has_pclmulqdq() const {
+    return has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::pclmulqdq);
+  }
+
+  /**
+   * AVX2 requires support from both the CPU and the operating system, which
+   * must save the upper halves of the YMM registers on context switches.
+   */
+  bool has_avx2() const {
+    return
+        has_os_avx_support() &&
+        ((_xcr0 & xcr0_ymm_state) == xcr0_ymm_state) &&
+        has_feature_bit(_extended_registers, cpu_register::ebx, cpu_feature_bit::avx2);
+  }
+
+  /**
+   * AVX-512BW additionally requires the operating system to save the opmask
+   * and ZMM register state.
+   */
+  bool has_avx512bw() const {
+    return
+        has_avx2() &&
+        ((_xcr0 & xcr0_zmm_state) == xcr0_zmm_state) &&
+        has_feature_bit(_extended_registers, cpu_register::ebx, cpu_feature_bit::avx512f) &&
+        has_feature_bit(_extended_registers, cpu_register::ebx, cpu_feature_bit::avx512bw);
   }
 
  private:
@@ -65,17 +90,66 @@ class cpuid {
 
   struct cpu_feature_bit {
     enum type {
-      sse_42 = 20,
+      pclmulqdq = 1,   // function 1, ecx
+      avx2 = 5,        // function 7, ebx
+      avx512f = 16,    // function 7, ebx
+      sse_42 = 20,     // function 1, ecx
+      osxsave = 27,    // function 1, ecx
+      avx = 28,        // function 1, ecx
+      avx512bw = 30    // function 7, ebx
     };
   };
 
-  bool has_feature_bit(
+  static constexpr uint64_t xcr0_ymm_state = 0x06;  // XMM | YMM
+  static constexpr uint64_t xcr0_zmm_state = 0xE6;  // XMM | YMM | opmask | ZMM
+
+  static void query(const uint32_t function, std::array<uint32_t, 4> &registers) {
+#if defined(_MSC_VER)
+    ::__cpuidex(reinterpret_cast<int *>(registers.data()), function, 0);
+#elif defined(__GNUC__)
+    __asm__ __volatile__ (
+        "cpuid ;\n"
+        : "=a" (registers[cpu_register::eax]),
+          "=b" (registers[cpu_register::ebx]),
+          "=c" (registers[cpu_register::ecx]),
+          "=d" (registers[cpu_register::edx])
+        : "a" (function), "c" (0)
+        :);
+#endif  // defined(_MSC_VER)
+  }
+
+  static uint64_t read_xcr0() {
+#if defined(_MSC_VER)
+    return ::_xgetbv(0);
+#elif defined(__GNUC__)
+    uint32_t eax, edx;
+    __asm__ __volatile__ (
+        "xgetbv ;\n"
+        : "=a" (eax), "=d" (edx)
+        : "c" (0)
+        :);
+    return (uint64_t(edx) << 32) | eax;
+#else
+    return 0;
+#endif  // defined(_MSC_VER)
+  }
+
+  bool has_os_avx_support() const {
+    return
+        has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::osxsave) &&
+        has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::avx);
+  }
+
+  static bool has_feature_bit(
+      const std::array<uint32_t, 4> &registers,
       const cpu_register::type &reg,
-      const cpu_feature_bit::type &bit) const {
-    return (_registers[reg] & (1 << bit)) != 0;
+      const cpu_feature_bit::type &bit) {
+    return (registers[reg] & (1u << bit)) != 0;
   }
 
-  std::array<uint32_t, 4> _registers;
+  std::array<uint32_t, 4> _registers = {};
+  std::array<uint32_t, 4> _extended_registers = {};
+  uint64_t _xcr0 = 0;
 };
 
 }  // namespace detail
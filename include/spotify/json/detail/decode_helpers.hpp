@@ -19,7 +19,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
@@ -166,6 +168,80 @@ json_never_inline void decode_comma_separated(decode_context &context, char intr
   context.position++;
 }
 
+/**
+ * Construct an empty value to decode into. Types that use a polymorphic
+ * allocator, such as std::pmr containers, allocate from the memory resource of
+ * the context when it has one.
+ */
+template <typename T>
+json_force_inline T construct(const decode_context &context) {
+  using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+  if constexpr (std::uses_allocator<T, allocator_type>::value) {
+    if (context.memory_resource) {
+      return T(allocator_type(context.memory_resource));
+    }
+  }
+  return T();
+}
+
+/**
+ * Store a decoded value in an existing value, such as an object member.
+ * Assignment keeps the allocator of the existing value, so a std::pmr value
+ * that was decoded into the memory resource of the context would be copied
+ * back into the resource of the existing value. Such values are instead move
+ * constructed in place, which keeps the memory resource they were decoded in.
+ */
+template <typename T, typename decoded_type>
+json_force_inline void assign_decoded(T &value, decoded_type &&decoded) {
+  using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+  if constexpr (
+      std::is_same<T, decoded_type>::value &&
+      std::uses_allocator<T, allocator_type>::value &&
+      std::is_nothrow_move_constructible<T>::value) {
+    if (value.get_allocator() != decoded.get_allocator()) {
+      value.~T();
+      new (&value) T(std::forward<decoded_type>(decoded));
+      return;
+    }
+  }
+  value = std::forward<decoded_type>(decoded);
+}
+
+template <typename T>
+struct has_decode_into_method {
+  template <typename U>
+  static auto test(int) -> decltype(
+      std::declval<const U &>().decode_into(
+          std::declval<decode_context &>(),
+          std::declval<typename U::object_type &>()),
+      std::true_type());
+
+  template <typename>
+  static std::false_type test(...);
+
+ public:
+  static constexpr bool value = std::is_same<decltype(test<T>(0)), std::true_type>::value;
+};
+
+/**
+ * Decode into an existing value. Codecs that have a decode_into method reuse
+ * the memory that the value already owns; for other codecs, this assigns the
+ * result of decode.
+ */
+template <typename codec_type, typename value_type>
+json_force_inline void decode_into(
+    const codec_type &codec,
+    decode_context &context,
+    value_type &value) {
+  if constexpr (
+      has_decode_into_method<codec_type>::value &&
+      std::is_same<typename codec_type::object_type, value_type>::value) {
+    codec.decode_into(context, value);
+  } else {
+    value = codec.decode(context);
+  }
+}
+
 /**
  * Helper for parsing JSON objects. callback is called once for each key/value
  * pair. It is given the already parsed key and is expected to parse the value
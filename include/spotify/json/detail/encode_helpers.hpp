@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/encode_exception.hpp>
 #include <spotify/json/encode_context.hpp>
@@ -61,6 +64,23 @@ json_force_inline should_encode(const codec_type &codec, const value_type &value
   return codec.should_encode(value);
 }
 
+/**
+ * The maximum number of bytes that a codec writes when encoding one value, or
+ * 0 if there is no such bound. Codecs of fixed-width values declare the bound
+ * with a static max_encoded_size member.
+ */
+template <typename T>
+struct max_encoded_size {
+  template <typename U>
+  static std::integral_constant<std::size_t, U::max_encoded_size> test(int);
+
+  template <typename>
+  static std::integral_constant<std::size_t, 0> test(...);
+
+ public:
+  static constexpr std::size_t value = decltype(test<T>(0))::value;
+};
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
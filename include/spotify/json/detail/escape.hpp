@@ -16,12 +16,25 @@
 
 #pragma once
 
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/macros.hpp>
 #include <spotify/json/encode_context.hpp>
 
 namespace spotify {
 namespace json {
 namespace detail {
 
+void write_escaped_scalar(encode_context &context, const char *begin, const char *end);
+#if defined(json_arch_x86_sse42)
+void write_escaped_sse42(encode_context &context, const char *begin, const char *end);
+#endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void write_escaped_avx2(encode_context &context, const char *begin, const char *end);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512)
+void write_escaped_avx512(encode_context &context, const char *begin, const char *end);
+#endif  // defined(json_arch_x86_avx512)
+
 /**
  * \brief Escape a string for use in a JSON string as per RFC 4627.
  *
@@ -30,7 +43,13 @@ namespace detail {
  *
  * See: http://www.ietf.org/rfc/rfc4627.txt (Section 2.5)
  */
-void write_escaped(encode_context &context, const char *begin, const char *end);
+json_force_inline void write_escaped(encode_context &context, const char *begin, const char *end) {
+#if defined(json_fixed_kernel)
+  json_fixed_kernel(write_escaped)(context, begin, end);
+#else
+  context.kernels->write_escaped(context, begin, end);
+#endif  // defined(json_fixed_kernel)
+}
 
 }  // namespace detail
 }  // namespace json
@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -35,47 +38,143 @@ namespace detail {
 // object_t. It needs a virtual destructor so the shared_ptr<detail::field>
 // deleter does the right thing.
 struct field {
-  field(bool required, size_t required_field_idx)
-      : _data(required ? required_field_idx : json_size_t_max) {}
+  field(bool required, size_t required_field_idx, bool always_encoded = false, size_t max_encoded_size = 0)
+      : _data(required ? required_field_idx : json_size_t_max),
+        _always_encoded(always_encoded),
+        _max_encoded_size(max_encoded_size) {}
   virtual ~field() = default;
 
   virtual void decode(decode_context &context, void *object) const = 0;
+
+  // Decode into the current value of the field, reusing the memory it owns.
+  virtual void decode_into(decode_context &context, void *object) const = 0;
+
+  // Set the field of object to its value in prototype, a default constructed
+  // object.
+  virtual void reset(void *object, const void *prototype) const = 0;
   virtual void encode(
       encode_context &context,
       const std::string &escaped_key,
       const void *object) const = 0;
 
+  // Encode only the value of the field, without the key and without checking
+  // should_encode. Only valid for fields that are always encoded.
+  virtual void encode_value(encode_context &context, const void *object) const = 0;
+
   json_force_inline bool is_required() const { return (_data != json_size_t_max); }
   json_force_inline size_t required_field_idx() const { return _data; }
 
+  // True if the codec of the field has no should_encode method, so that the
+  // field is written for every object.
+  json_force_inline bool is_always_encoded() const { return _always_encoded; }
+
+  // The maximum size of the encoded value, or 0 if it is not bounded.
+  json_force_inline size_t max_encoded_size() const { return _max_encoded_size; }
+
  private:
   size_t _data;
+  bool _always_encoded;
+  size_t _max_encoded_size;
 };
 
 // Non-templated class to reduce code bloat.
+//
+// Fields are looked up by name with a perfect hash table that is built with the
+// hash-and-displace method: the names are hashed into buckets, and each bucket
+// gets a displacement value that moves all of its names into free slots of the
+// table. A lookup is then one hash of the name, one slot load and one
+// comparison, without any allocations.
+//
+// Fields are saved one at a time while a codec is set up, so the hash table and
+// the encode plan are not built by save(). They are built once, on the first
+// lookup or encode after the last save(), or when the registry is copied or
+// moved. The build is thread safe, so the first uses may happen concurrently.
+// If no seed gives a perfect hash table, which takes names with colliding
+// 64-bit hashes, the names are binary searched instead.
 class field_registry final {
  public:
   using field_vec = std::vector<std::pair<std::string, std::shared_ptr<const field>>>;
-  using field_map = std::unordered_map<std::string, std::shared_ptr<const field>>;
   using const_iterator = typename field_vec::const_iterator;
 
   field_registry();
   ~field_registry();
   field_registry(const field_registry &);
   field_registry(field_registry &&);
+  field_registry &operator=(const field_registry &);
+  field_registry &operator=(field_registry &&);
 
   // Forward the iterator implementation so range based for works.
   inline const_iterator begin() const noexcept { return _field_list.begin(); }
   inline const_iterator end() const noexcept { return _field_list.end(); }
 
+  inline size_t size() const noexcept { return _field_list.size(); }
+  inline const field_vec::value_type &operator[](size_t index) const noexcept {
+    return _field_list[index];
+  }
+
   void save(const std::string &name, bool required, const std::shared_ptr<field> &f);
-  const field *find(const std::string &name) const noexcept;
+  const field *find(const char *name, size_t size) const;
+  const field *find(const std::string &name) const;
+
+  // The index of the field in the order the fields were saved in, or
+  // json_size_t_max if there is no field with that name.
+  size_t find_index(const char *name, size_t size) const;
+  size_t find_index(const std::string &name) const;
+
   size_t num_required_fields() const noexcept { return _num_required_fields; }
 
+  // When all fields are always encoded, the constant text around the field
+  // values, merged into one literal per gap: {"a": ,"b": ... } so that there
+  // is one more literal than there are fields. Empty if some field may be
+  // omitted when encoding.
+  const std::vector<std::string> &encode_literals() const {
+    prepare();
+    return _encode_literals;
+  }
+
+  // The number of bytes to reserve before encoding with encode_literals. This
+  // is an upper bound of the encoded size if all fields have fixed-width
+  // values, and the size of the literals plus any known value sizes otherwise.
+  size_t encode_size_hint() const {
+    prepare();
+    return _encode_size_hint;
+  }
+
  private:
-  field_vec _field_list;
-  field_map _fields;
+  json_force_inline void prepare() const {
+    if (json_unlikely(!_built.load(std::memory_order_acquire))) {
+      build();
+    }
+  }
+
+  template <typename registry_type>
+  void assign(registry_type &&other);
+
+  void build() const;
+  void build_encode_plan() const;
+  void build_hash_table() const;
+  bool try_build_hash_table(uint64_t seed) const;
+  void build_sorted_names() const;
+  size_t slot(uint64_t hash) const noexcept;
+  size_t lookup(const char *name, size_t size) const noexcept;
+
+  field_vec _field_list;  // escaped keys, in the order they were saved
+  std::vector<std::string> _names;  // unescaped keys, same order as _field_list
   size_t _num_required_fields = 0;
+
+  // Names saved since the lookup table was last built, to find duplicates
+  // without rebuilding the table. Released when the table is built.
+  mutable std::unordered_set<std::string> _unbuilt_names;
+
+  // Built lazily from the fields above, see prepare().
+  mutable std::atomic<bool> _built{true};
+  mutable std::unique_ptr<std::once_flag> _build_once = std::make_unique<std::once_flag>();
+  mutable std::vector<uint32_t> _displacements;  // one per bucket
+  mutable std::vector<uint32_t> _slots;  // 1 + index into _field_list, or 0 if empty
+  mutable std::vector<uint32_t> _sorted;  // indices sorted by name, without a perfect hash
+  mutable uint64_t _seed = 0;
+  mutable std::vector<std::string> _encode_literals = std::vector<std::string>(1, "{}");
+  mutable size_t _encode_size_hint = 2;
 };
 
 }  // namespace detail
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Split a JSON Pointer (RFC 6901), such as "/tracks/0/uri", into its reference
+ * tokens, with "~1" unescaped to "/" and "~0" to "~". The empty pointer refers
+ * to the whole document and has no tokens.
+ *
+ * @throws std::invalid_argument if the pointer is malformed.
+ */
+std::vector<std::string> parse_json_pointer(std::string_view pointer);
+
+/**
+ * Parse a reference token as an array index, which is "0" or a decimal number
+ * without leading zeros. Returns json_size_t_max if the token is not an index.
+ */
+size_t parse_array_index(std::string_view token);
+
+/**
+ * Read the key at context.position and advance past it. Keys without escape
+ * sequences are returned as views of the input; other keys are unescaped into
+ * scratch.
+ */
+std::string_view read_key(decode_context &context, std::string &scratch);
+
+/**
+ * Advance context.position from the '{' of an object to the beginning of the
+ * value of the first member with the given key, skipping the values of the
+ * other members with skip_value. Returns false, with context.position after
+ * the '}', if the object has no such member.
+ */
+bool find_object_member(decode_context &context, std::string_view key);
+
+/**
+ * Like find_object_member, but starts at the value of a member of the object
+ * and only looks at the members after it.
+ */
+bool find_next_object_member(decode_context &context, std::string_view key);
+
+/**
+ * Advance context.position from the '[' of an array to the beginning of the
+ * element at index. Returns false, with context.position after the ']', if
+ * the array is shorter than that.
+ */
+bool find_array_element(decode_context &context, size_t index);
+
+/**
+ * Advance context.position from the beginning of a value to the beginning of
+ * the value that the reference tokens of a JSON Pointer refer to inside of it.
+ * The values that are passed on the way are skipped with skip_value.
+ *
+ * @throws decode_exception if there is no such value.
+ */
+void seek_json_pointer(decode_context &context, const std::vector<std::string> &tokens);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+
+struct decode_context;
+struct encode_context;
+
+namespace detail {
+
+struct structural_state;
+
+enum class kernel_tier {
+  scalar = 0,
+  sse42 = 1,
+  avx2 = 2,
+  avx512 = 3
+};
+
+/**
+ * The set of kernels that the decoding and encoding helpers use for their hot
+ * loops. There is one table per kernel tier, and every context points at one
+ * of them. Unless the library is built with a fixed kernel tier (in which case
+ * json_fixed_kernel is defined and the kernels are called directly), helpers
+ * such as skip_any_whitespace call through the table of their context.
+ */
+struct kernel_table {
+  kernel_tier tier;
+  void (*skip_any_simple_characters)(decode_context &context);
+  void (*skip_any_whitespace)(decode_context &context);
+  void (*write_escaped)(encode_context &context, const char *begin, const char *end);
+  void (*index_structurals)(structural_state &state, const char *begin, const char *end, uint64_t *opens, uint64_t *closes);
+};
+
+/**
+ * The kernel table for the widest tier that the CPU supports. The CPU features
+ * are only detected once per process.
+ */
+const kernel_table &default_kernel_table();
+
+/**
+ * The kernel table for the given tier. If the library was not built with that
+ * tier, or if the CPU does not support it, the table of the widest available
+ * tier below it is returned instead.
+ */
+const kernel_table &kernel_table_for(kernel_tier tier);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
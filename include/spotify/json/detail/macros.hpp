@@ -25,6 +25,7 @@
   #define json_likely(expr) (expr)
   #define json_unlikely(expr) (expr)
   #define json_unreachable() std::abort()
+  #define json_prefetch(addr) ((void)(addr))
 #elif defined(__GNUC__)
   #define json_force_inline __attribute__((always_inline)) inline
   #define json_never_inline __attribute__((noinline))
@@ -32,6 +33,7 @@
   #define json_likely(expr) __builtin_expect(!!(expr), 1)
   #define json_unlikely(expr) __builtin_expect(!!(expr), 0)
   #define json_unreachable() __builtin_unreachable()
+  #define json_prefetch(addr) __builtin_prefetch(addr)
 #else
   #define json_force_inline inline
   #define json_never_inline
@@ -39,6 +41,7 @@
   #define json_likely(expr) (expr)
   #define json_unlikely(expr) (expr)
   #define json_unreachable() std::abort()
+  #define json_prefetch(addr) ((void)(addr))
 #endif  // _MSC_VER
 
 #ifdef max
@@ -87,3 +90,23 @@
 #if defined(json_arch_x86) && defined(SPOTIFY_JSON_USE_SSE42)
   #define json_arch_x86_sse42
 #endif
+
+#if defined(json_arch_x86) && defined(SPOTIFY_JSON_USE_AVX2)
+  #define json_arch_x86_avx2
+#endif
+
+#if defined(json_arch_x86) && defined(SPOTIFY_JSON_USE_AVX512)
+  #define json_arch_x86_avx512
+#endif
+
+// When the library is built with a fixed kernel tier, the kernel dispatch table
+// is bypassed and the kernels of that tier are called directly. See kernels.hpp
+#if defined(SPOTIFY_JSON_KERNEL_TIER_SCALAR)
+  #define json_fixed_kernel(name) name ## _scalar
+#elif defined(SPOTIFY_JSON_KERNEL_TIER_SSE42) && defined(json_arch_x86_sse42)
+  #define json_fixed_kernel(name) name ## _sse42
+#elif defined(SPOTIFY_JSON_KERNEL_TIER_AVX2) && defined(json_arch_x86_avx2)
+  #define json_fixed_kernel(name) name ## _avx2
+#elif defined(SPOTIFY_JSON_KERNEL_TIER_AVX512) && defined(json_arch_x86_avx512)
+  #define json_fixed_kernel(name) name ## _avx512
+#endif
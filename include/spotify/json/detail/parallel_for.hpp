@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The number of threads to use for a requested number of threads, where 0
+ * means one thread per hardware thread.
+ */
+std::size_t resolve_num_threads(std::size_t num_threads);
+
+/**
+ * Run task(i) for every i in [0, num_tasks) on up to num_threads threads, one
+ * of which is the calling thread. A num_threads of 0 means one thread per
+ * hardware thread. The tasks are handed out one at a time from a shared
+ * counter, so threads that finish early take over the remaining work.
+ *
+ * If tasks throw, no new tasks are started, and the exception of the failed
+ * task with the lowest index is rethrown once all threads have stopped.
+ */
+void parallel_for(
+    std::size_t num_tasks,
+    std::size_t num_threads,
+    const std::function<void (std::size_t)> &task);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
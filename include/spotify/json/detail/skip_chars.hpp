@@ -17,6 +17,7 @@
 #pragma once
 
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/kernels.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 namespace spotify {
@@ -27,42 +28,54 @@ void skip_any_simple_characters_scalar(decode_context &context);
 #if defined(json_arch_x86_sse42)
 void skip_any_simple_characters_sse42(decode_context &context);
 #endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_simple_characters_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512)
+void skip_any_simple_characters_avx512(decode_context &context);
+#endif  // defined(json_arch_x86_avx512)
 
 /**
  * Skip past the bytes of the string until either a " or a \ character is
  * found. This method attempts to skip as large chunks of memory as possible
  * at each step, by making sure that the context position is aligned to the
  * appropriate address and then reading and comparing several bytes in a
- * single read operation.
+ * single read operation. The kernel is picked by the kernel table of the
+ * context, see kernels.hpp.
  */
 json_force_inline void skip_any_simple_characters(decode_context &context) {
-#if defined(json_arch_x86_sse42)
-  if (json_likely(context.has_sse42)) {
-    return skip_any_simple_characters_sse42(context);
-  }
-#endif  // defined(json_arch_x86_sse42)
-  return skip_any_simple_characters_scalar(context);
+#if defined(json_fixed_kernel)
+  json_fixed_kernel(skip_any_simple_characters)(context);
+#else
+  context.kernels->skip_any_simple_characters(context);
+#endif  // defined(json_fixed_kernel)
 }
 
 void skip_any_whitespace_scalar(decode_context &context);
 #if defined(json_arch_x86_sse42)
 void skip_any_whitespace_sse42(decode_context &context);
 #endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_whitespace_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512)
+void skip_any_whitespace_avx512(decode_context &context);
+#endif  // defined(json_arch_x86_avx512)
 
 /**
  * Skip past the bytes of the string until a non-whitespace character is
  * found. This method attempts to skip as large chunks of memory as possible
  * at each step, by making sure that the context position is aligned to the
  * appropriate address and then reading and comparing several bytes in a
- * single read operation.
+ * single read operation. The kernel is picked by the kernel table of the
+ * context, see kernels.hpp.
  */
 json_force_inline void skip_any_whitespace(decode_context &context) {
-#if defined(json_arch_x86_sse42)
-  if (json_likely(context.has_sse42)) {
-    return skip_any_whitespace_sse42(context);
-  }
-#endif  // defined(json_arch_x86_sse42)
-  skip_any_whitespace_scalar(context);
+#if defined(json_fixed_kernel)
+  json_fixed_kernel(skip_any_whitespace)(context);
+#else
+  context.kernels->skip_any_whitespace(context);
+#endif  // defined(json_fixed_kernel)
 }
 
 }  // namespace detail
@@ -31,6 +31,18 @@ namespace detail {
  */
 void skip_value(decode_context &context);
 
+/**
+ * Skip past one JSON string, including its quotes. The escape sequences in
+ * the string are validated.
+ */
+void skip_string(decode_context &context);
+
+/**
+ * Skip past one JSON number. context.position is left at the first character
+ * after the number, which is not validated.
+ */
+void skip_number(decode_context &context);
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
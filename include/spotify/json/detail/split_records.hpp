@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/kernels.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+struct record {
+  const char *begin;
+  const char *end;
+};
+
+/**
+ * Split [begin, end) into the JSON values that it contains, which may be
+ * separated by whitespace (such as the newlines of NDJSON) or concatenated.
+ * The ends of arrays and objects are found with a structural index of the
+ * whole buffer, so the values inside of them are not looked at; other values
+ * are found with a value_scanner. The records are only checked for balanced
+ * brackets and terminated strings.
+ *
+ * @throws decode_exception if a value is not terminated.
+ */
+std::vector<record> split_records(const char *begin, const char *end, const kernel_table &kernels);
+
+/**
+ * Split the elements of the array at context.position into slices of about
+ * slice_size bytes each, and advance context.position past the array. A
+ * slice spans from the first character of its first element to the ',' or
+ * ']' after its last element, so a slice can be decoded as a comma separated
+ * list of elements. Arrays and objects are skipped with the structural index
+ * of the context when it has one.
+ *
+ * @throws decode_exception if the array is malformed.
+ */
+std::vector<record> split_array(decode_context &context, size_t slice_size);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
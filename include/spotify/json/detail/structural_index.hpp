@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The string state that is carried from one 64 byte block of input to the
+ * next while building a structural index: whether the previous block ended in
+ * an odd number of backslashes (so that the first character of the next block
+ * is escaped), and whether it ended inside of a string.
+ */
+struct structural_state {
+  uint64_t ends_odd_backslash = 0;
+  uint64_t inside_string = 0;  // all ones or all zeros
+};
+
+/**
+ * Index the brackets in [begin, end) that are not inside of strings. Bit i of
+ * opens[n] (closes[n]) is set when begin[n * 64 + i] is '{' or '[' ('}' or
+ * ']'). The output arrays must hold one word per started 64 byte block.
+ */
+void index_structurals_scalar(structural_state &state, const char *begin, const char *end, uint64_t *opens, uint64_t *closes);
+#if defined(json_arch_x86_sse42)
+void index_structurals_sse42(structural_state &state, const char *begin, const char *end, uint64_t *opens, uint64_t *closes);
+#endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void index_structurals_avx2(structural_state &state, const char *begin, const char *end, uint64_t *opens, uint64_t *closes);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512)
+void index_structurals_avx512(structural_state &state, const char *begin, const char *end, uint64_t *opens, uint64_t *closes);
+#endif  // defined(json_arch_x86_avx512)
+
+/**
+ * A structural index is a bitmap of the brackets of a JSON buffer that are not
+ * inside of strings. It is built in a single SIMD pass over the buffer (often
+ * called "stage 1"), and allows skip_value to jump from an opening bracket to
+ * its matching closing bracket without looking at the characters in between.
+ *
+ * When a decode_context has a structural index, skipped arrays and objects are
+ * only checked for balanced brackets and terminated strings; the values inside
+ * of them are not validated.
+ */
+class structural_index final {
+ public:
+  structural_index(const char *begin, const char *end);
+  structural_index(const char *begin, const char *end, const kernel_table &kernels);
+
+  json_force_inline const char *begin() const {
+    return _begin;
+  }
+
+  json_force_inline const char *end() const {
+    return _end;
+  }
+
+  /**
+   * Find the bracket that closes the bracket at open, which must be an opening
+   * bracket within the indexed buffer. The brackets are only balanced, so the
+   * returned bracket may be of a different kind than the opening one. Returns
+   * nullptr if the bracket is never closed.
+   */
+  const char *find_matching_close(const char *open) const;
+
+ private:
+  const char *_begin;
+  const char *_end;
+  std::vector<uint64_t> _opens;
+  std::vector<uint64_t> _closes;
+};
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Load 8 bytes from p into a uint64_t with the first byte in the least
+ * significant position, whatever the byte order of the machine is.
+ */
+json_force_inline uint64_t load_le_8(const char *p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  value = __builtin_bswap64(value);
+#endif
+  return value;
+}
+
+/**
+ * True if all 8 bytes of a value loaded with load_le_8 are '0' through '9'.
+ * Bytes below '0' make the subtraction borrow, and bytes above '9' make the
+ * addition carry, into the high bit of their byte.
+ */
+json_force_inline bool is_eight_digits(const uint64_t value) {
+  return !(((value + 0x4646464646464646ULL) | (value - 0x3030303030303030ULL)) & 0x8080808080808080ULL);
+}
+
+/**
+ * The value of 8 decimal digits loaded with load_le_8, the first of which is
+ * the most significant. The digits are combined pairwise in three steps: into
+ * four 2 digit numbers, two 4 digit numbers and finally one 8 digit number.
+ */
+json_force_inline uint32_t parse_eight_digits(uint64_t value) {
+  const uint64_t mask = 0x000000FF000000FFULL;
+  const uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000 << 32)
+  const uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+  value -= 0x3030303030303030ULL;
+  value = (value * 10) + (value >> 8);
+  value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+  return uint32_t(value);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
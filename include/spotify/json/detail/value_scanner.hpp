@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/stack.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Finds the end of a JSON value whose bytes arrive in consecutive chunks. The
+ * scanner keeps its state between calls to scan, including the nesting stack,
+ * so every byte is looked at only once, no matter how the value is split.
+ *
+ * Only the structure needed to find the end of the value is checked: brackets
+ * must match and strings must be terminated. The value itself is validated
+ * when it is decoded.
+ */
+class value_scanner final {
+ public:
+  explicit value_scanner(const kernel_table &kernels = default_kernel_table());
+
+  /**
+   * Scan the next chunk of the value. Returns a pointer to one past the end of
+   * the value if it ends in [begin, end), or nullptr if more data is needed.
+   * After the end of the value has been found, the scanner must be reset
+   * before it scans the next value.
+   *
+   * @throws decode_exception if the brackets of the value do not match.
+   */
+  const char *scan(const char *begin, const char *end);
+
+  /**
+   * Signal that there is no more input. Returns true if a value has ended,
+   * which is the case for numbers and literals that are terminated by the end
+   * of input, and false if no value has been started.
+   *
+   * @throws decode_exception if the input ends inside of a value.
+   */
+  bool finish();
+
+  /**
+   * The number of bytes scanned since the scanner was constructed or reset.
+   */
+  std::size_t offset() const { return _offset; }
+
+  void reset();
+
+ private:
+  enum class state : uint8_t {
+    before_value,
+    in_container,
+    in_string,
+    in_string_escape,
+    in_scalar,
+    done
+  };
+
+  json_noreturn void fail(const char *error, std::size_t offset) const;
+
+  const kernel_table *_kernels;
+  stack<char, 64> _stack;
+  char _inside = 0;  // '{' or '[' when inside a container, 0 at the top level
+  state _state = state::before_value;
+  std::size_t _offset = 0;
+};
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
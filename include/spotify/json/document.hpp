@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+
+namespace spotify {
+namespace json {
+
+class document;
+class dom_value;
+
+enum class dom_type {
+  null,
+  boolean,
+  number,
+  string,
+  array,
+  object
+};
+
+namespace detail {
+
+enum class tape_tag : uint8_t {
+  null_value,
+  true_value,
+  false_value,
+  number,
+  string,
+  escaped_string,
+  array_open,
+  array_close,
+  object_open,
+  object_close
+};
+
+/**
+ * One token of a document. word holds the tag in its low 8 bits and a 56 bit
+ * payload above it:
+ *
+ *  - array_open / object_open: the number of entries from this entry to the
+ *    one after the matching close, so that skipping a container is O(1).
+ *    pointer is the '[' or '{' in the input.
+ *  - array_close / object_close: the number of entries back to the matching
+ *    open. pointer is the ']' or '}' in the input.
+ *  - string: the length of the string, which is pointer in the input.
+ *  - escaped_string: the length of the unescaped string. pointer is an
+ *    escaped_string in the arena of the document.
+ *  - number: the length of the number text, which is pointer in the input.
+ *  - null_value / true_value / false_value: pointer is the literal in the input.
+ */
+struct tape_entry {
+  tape_entry(const tape_tag tag, const size_t payload, const void *pointer)
+      : word((uint64_t(payload) << 8) | uint64_t(tag)),
+        pointer(pointer) {}
+
+  tape_tag tag() const { return tape_tag(word & 0xFF); }
+  size_t payload() const { return size_t(word >> 8); }
+
+  uint64_t word;
+  const void *pointer;
+};
+
+/**
+ * A string that contained escape sequences, with its unescaped value and its
+ * text in the input (between the quotes).
+ */
+struct escaped_string {
+  std::string_view value;
+  std::string_view source;
+};
+
+json_force_inline const tape_entry *next_sibling(const tape_entry *entry) {
+  const auto tag = entry->tag();
+  const auto is_open = (tag == tape_tag::array_open || tag == tape_tag::object_open);
+  return entry + (is_open ? entry->payload() : 1);
+}
+
+}  // namespace detail
+
+template <typename iterator_type>
+class dom_range final {
+ public:
+  dom_range(iterator_type begin, iterator_type end) : _begin(begin), _end(end) {}
+
+  iterator_type begin() const { return _begin; }
+  iterator_type end() const { return _end; }
+
+ private:
+  iterator_type _begin;
+  iterator_type _end;
+};
+
+/**
+ * A read only view of one value in a document. It is a single pointer into
+ * the tape of the document, so it is cheap to copy, and it is valid for as
+ * long as the document (and the input that the document points into) is.
+ *
+ * Accessors that require a certain type throw std::invalid_argument when the
+ * value has another type.
+ */
+class dom_value final {
+ public:
+  class array_iterator;
+  class object_iterator;
+
+  explicit dom_value(const detail::tape_entry *entry) : _entry(entry) {}
+
+  dom_type type() const;
+
+  bool is_null() const { return type() == dom_type::null; }
+  bool is_bool() const { return type() == dom_type::boolean; }
+  bool is_number() const { return type() == dom_type::number; }
+  bool is_string() const { return type() == dom_type::string; }
+  bool is_array() const { return type() == dom_type::array; }
+  bool is_object() const { return type() == dom_type::object; }
+
+  bool as_bool() const;
+
+  /**
+   * The unescaped value of a string. It points into the input when the string
+   * has no escape sequences, and into the arena of the document otherwise.
+   */
+  std::string_view as_string() const;
+
+  /**
+   * The text of a number, as it is in the input. as_double, as_int64 and
+   * as_uint64 convert it on each call and throw decode_exception if it does
+   * not fit in the requested type.
+   */
+  std::string_view number_text() const;
+  double as_double() const;
+  int64_t as_int64() const;
+  uint64_t as_uint64() const;
+
+  /**
+   * The number of elements of an array or members of an object. This is
+   * linear in the number of children, since each child is skipped in O(1).
+   */
+  size_t size() const;
+
+  /**
+   * The element at index of an array. Throws std::out_of_range if there is no
+   * such element.
+   */
+  dom_value operator[](size_t index) const;
+
+  /**
+   * The value of the first member of an object with the given key, or
+   * nothing if the object has no such member. Members are compared in order
+   * and the value of every member that does not match is skipped in O(1).
+   */
+  std::optional<dom_value> find(std::string_view key) const;
+
+  /**
+   * Like find, but throws std::out_of_range if there is no member with key.
+   */
+  dom_value operator[](std::string_view key) const;
+
+  /**
+   * The elements of an array and the members of an object, in input order.
+   */
+  dom_range<array_iterator> elements() const;
+  dom_range<object_iterator> members() const;
+
+  /**
+   * The text of the value in the input, from its first to its last character.
+   * It can be passed to json::decode to decode the value with a codec.
+   */
+  std::string_view json() const;
+
+  friend bool operator==(const dom_value &a, const dom_value &b) { return a._entry == b._entry; }
+  friend bool operator!=(const dom_value &a, const dom_value &b) { return a._entry != b._entry; }
+
+ private:
+  const detail::tape_entry *expect(detail::tape_tag open_tag, const char *message) const;
+
+  const detail::tape_entry *_entry;
+};
+
+/**
+ * A member of a JSON object in a document: its unescaped key and its value.
+ */
+struct dom_member {
+  std::string_view key;
+  dom_value value;
+};
+
+class dom_value::array_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = dom_value;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const dom_value *;
+  using reference = dom_value;
+
+  explicit array_iterator(const detail::tape_entry *entry) : _entry(entry) {}
+
+  dom_value operator*() const { return dom_value(_entry); }
+
+  array_iterator &operator++() {
+    _entry = detail::next_sibling(_entry);
+    return *this;
+  }
+
+  array_iterator operator++(int) {
+    const auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  friend bool operator==(const array_iterator &a, const array_iterator &b) { return a._entry == b._entry; }
+  friend bool operator!=(const array_iterator &a, const array_iterator &b) { return a._entry != b._entry; }
+
+ private:
+  const detail::tape_entry *_entry;
+};
+
+class dom_value::object_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = dom_member;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const dom_member *;
+  using reference = dom_member;
+
+  explicit object_iterator(const detail::tape_entry *entry) : _entry(entry) {}
+
+  dom_member operator*() const {
+    return dom_member{ dom_value(_entry).as_string(), dom_value(_entry + 1) };
+  }
+
+  object_iterator &operator++() {
+    _entry = detail::next_sibling(_entry + 1);
+    return *this;
+  }
+
+  object_iterator operator++(int) {
+    const auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  friend bool operator==(const object_iterator &a, const object_iterator &b) { return a._entry == b._entry; }
+  friend bool operator!=(const object_iterator &a, const object_iterator &b) { return a._entry != b._entry; }
+
+ private:
+  const detail::tape_entry *_entry;
+};
+
+/**
+ * A parsed JSON value that can be inspected without knowing its schema up
+ * front. The value is stored as a tape: a flat array with one entry per token,
+ * in input order, where every array and object knows where it ends so that it
+ * can be skipped without looking at its contents. Strings without escape
+ * sequences and numbers point into the input. Only strings with escape
+ * sequences are unescaped, into an arena owned by the document.
+ *
+ * A document built from a pointer and a size refers to the input, which must
+ * outlive it. A document built from a std::string owns it. A default
+ * constructed document is the JSON value null.
+ */
+class document final {
+ public:
+  document();
+
+  /**
+   * Parse the JSON value in [data, data + size) into a document that refers
+   * to the input.
+   *
+   * @throws decode_exception if the input is not a valid JSON value.
+   */
+  document(const char *data, size_t size);
+
+  /**
+   * Parse json into a document that takes ownership of it.
+   *
+   * @throws decode_exception if json is not a valid JSON value.
+   */
+  explicit document(std::string json);
+
+  /**
+   * Parse the JSON value at context.position, and advance the context past
+   * it, into a document that owns a copy of the text of the value. This is
+   * what codec::document_t does.
+   *
+   * @throws decode_exception if there is no valid JSON value at the position.
+   */
+  explicit document(decode_context &context);
+
+  /**
+   * Copying a document parses a copy of the text of its root value, which
+   * the new document owns.
+   */
+  document(const document &other);
+  document &operator=(const document &other);
+  document(document &&) = default;
+  document &operator=(document &&) = default;
+
+  dom_value root() const { return dom_value(_tape.data()); }
+
+  /**
+   * The number of tape entries of the document.
+   */
+  size_t tape_size() const { return _tape.size(); }
+
+ private:
+  void build(decode_context &context);
+
+  std::unique_ptr<std::string> _source;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> _arena;
+  std::vector<detail::tape_entry> _tape;
+};
+
+}  // namespace json
+}  // namespace spotify
@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <spotify/json/detail/kernels.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 namespace spotify {
@@ -87,7 +88,15 @@ struct encode_context final {
 
   std::unique_ptr<void, decltype(std::free) *> steal_data();
 
-  const bool has_sse42;
+  /**
+   * Whether the kernels of this context use SSE 4.2 or wider instructions.
+   * This used to be a data member; it is now derived from the kernel table.
+   */
+  json_force_inline bool has_sse42() const {
+    return (kernels->tier >= detail::kernel_tier::sse42);
+  }
+
+  const detail::kernel_table *kernels;
 
  private:
   char * grow_buffer(const std::size_t num_bytes);
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <spotify/json/detail/encode_helpers.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+
+struct encode_range_options {
+  /**
+   * The encoded output is passed to the sink whenever at least this many bytes
+   * are buffered, and once at the end.
+   */
+  std::size_t flush_size = 1 << 16;
+};
+
+/*
+ * json::encode_range(codec, first, last, sink, options)
+ *
+ * Encode the elements of a range as a JSON array, with codec as the codec of
+ * the elements, without a container that holds all of the elements. The range
+ * is iterated over once, so single pass iterators such as those of a database
+ * cursor or a generator work, and only one element needs to exist at a time.
+ *
+ * The output is passed to sink(const char *data, size_t size) in pieces of
+ * about options.flush_size bytes, so memory use is bounded by one element and
+ * the output buffer. Elements that the codec says should not be encoded are
+ * left out, like with array_t.
+ */
+
+template <
+    typename codec_type,
+    typename input_iterator,
+    typename sentinel_type,
+    typename sink_type,
+    typename = typename std::enable_if<!std::is_same<
+        typename std::decay<sink_type>::type,
+        encode_range_options>::value>::type>
+void encode_range(
+    const codec_type &codec,
+    input_iterator first,
+    const sentinel_type last,
+    sink_type &&sink,
+    const encode_range_options &options = encode_range_options()) {
+  encode_context context(options.flush_size + options.flush_size / 4);
+  context.append('[');
+
+  bool empty = true;
+  for (; first != last; ++first) {
+    auto &&element = *first;
+    if (json_likely(detail::should_encode(codec, element))) {
+      if (json_likely(!empty)) {
+        context.append(',');
+      }
+      codec.encode(context, element);
+      empty = false;
+
+      if (context.size() >= options.flush_size) {
+        sink(context.data(), context.size());
+        context.clear();
+      }
+    }
+  }
+
+  context.append(']');
+  sink(context.data(), context.size());
+}
+
+template <typename codec_type, typename range_type, typename sink_type>
+void encode_range(
+    const codec_type &codec,
+    range_type &&range,
+    sink_type &&sink,
+    const encode_range_options &options = encode_range_options()) {
+  using std::begin;
+  using std::end;
+  encode_range(codec, begin(range), end(range), std::forward<sink_type>(sink), options);
+}
+
+/*
+ * json::encode_range(codec, range)
+ *
+ * Encode the elements of a range as a JSON array into a string.
+ */
+
+template <typename codec_type, typename range_type>
+std::string encode_range(const codec_type &codec, range_type &&range) {
+  std::string json;
+  encode_range(codec, std::forward<range_type>(range), [&](const char *data, std::size_t size) {
+    json.append(data, size);
+  });
+  return json;
+}
+
+}  // namespace json
+}  // namespace spotify
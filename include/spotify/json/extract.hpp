@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/encoded_value.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * The values that an extractor found, in the order of its pointers. A value
+ * is empty when its pointer refers to nothing in the input.
+ */
+class extracted_values final {
+ public:
+  extracted_values(const char *begin, size_t size)
+      : _begin(begin),
+        _values(size) {}
+
+  size_t size() const { return _values.size(); }
+
+  /**
+   * The text of the value of the pointer at index, which points into the
+   * input.
+   */
+  const std::optional<encoded_value_ref> &operator[](const size_t index) const {
+    return _values[index];
+  }
+
+  /**
+   * Decode the value of the pointer at index with a codec, or with the
+   * default codec of value_type. Returns nothing if the value was not found.
+   * Error offsets are counted from the beginning of the input.
+   */
+  template <typename codec_type>
+  std::optional<typename codec_type::object_type> get(const codec_type &codec, const size_t index) const {
+    const auto &value = _values[index];
+    if (!value) {
+      return std::nullopt;
+    }
+    decode_context context(_begin, value->data() + value->size());
+    context.position = value->data();
+    return codec.decode(context);
+  }
+
+  template <typename value_type>
+  std::optional<value_type> get(const size_t index) const {
+    return get(default_codec<value_type>(), index);
+  }
+
+ private:
+  friend class extractor;
+
+  const char *_begin;
+  std::vector<std::optional<encoded_value_ref>> _values;
+};
+
+/**
+ * Finds the values of a set of JSON Pointers (RFC 6901) in a single pass over
+ * the input. The pointers are compiled into a tree of their reference tokens
+ * once, when the extractor is created, so that one extractor can be used for
+ * many inputs. Values that no pointer reaches into are skipped with
+ * skip_value, and the pass stops as soon as every pointer has been found.
+ *
+ * Only the parts of the input that are read are validated. When an object has
+ * several members with the same key, the first of them is used.
+ */
+class extractor final {
+ public:
+  /**
+   * @throws std::invalid_argument if a pointer is malformed.
+   */
+  explicit extractor(const std::vector<std::string_view> &pointers);
+
+  size_t size() const { return _num_pointers; }
+
+  /**
+   * @throws decode_exception if the input is not valid JSON, as far as it was
+   *     read.
+   */
+  extracted_values extract(const char *data, size_t size) const;
+  extracted_values extract(const encoded_value_ref &json) const;
+
+ private:
+  /**
+   * A reference token of one or more pointers. children are the indices of
+   * the nodes for the tokens after it, and pointers the indices of the
+   * pointers that end at it. index is the token as an array index, or
+   * json_size_t_max if it is not one.
+   */
+  struct node {
+    std::string token;
+    size_t index;
+    std::vector<size_t> children;
+    std::vector<size_t> pointers;
+  };
+
+  struct walk_state;
+
+  bool walk(walk_state &state, const node &current) const;
+  bool walk_object(walk_state &state, const node &current) const;
+  bool walk_array(walk_state &state, const node &current) const;
+
+  std::vector<node> _nodes;
+  size_t _num_pointers;
+};
+
+/*
+ * json::extract(json, pointers)
+ *
+ * Find the values of a set of JSON Pointers in one pass over json. This is
+ * the same as extractor(pointers).extract(json); keep the extractor around
+ * to extract the same pointers from many inputs.
+ */
+
+inline extracted_values extract(const encoded_value_ref &json, const std::vector<std::string_view> &pointers) {
+  return extractor(pointers).extract(json);
+}
+
+inline extracted_values extract(const char *data, size_t size, const std::vector<std::string_view> &pointers) {
+  return extractor(pointers).extract(data, size);
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/value_scanner.hpp>
+
+namespace spotify {
+namespace json {
+
+enum class decode_status {
+  need_more_data,  // no decoded value is queued, and the input has not ended
+  ready,           // a decoded value is queued and can be taken with next()
+  done             // the input has ended and all values have been taken
+};
+
+/**
+ * Decodes JSON values from input that arrives in chunks, such as data read
+ * from a socket. The chunks are passed to feed, which reports whether a value
+ * is ready. The end of each value is found with a detail::value_scanner that
+ * keeps its state between chunks, so that each byte is scanned once regardless
+ * of how the input is split.
+ *
+ * Values that lie within one chunk are decoded directly from the chunk when it
+ * is fed, and queued until they are taken with next. Only the input after the
+ * last complete value of a chunk is copied into a buffer, which is completed
+ * and decoded when the rest of the value arrives. Values that refer to their
+ * input, such as those of string_view_t, point into the chunk they were
+ * decoded from, or into the buffer, which is reused by the next call to feed
+ * or finish.
+ *
+ * The input may contain several values, separated by whitespace or directly
+ * concatenated. Numbers and literals at the top level are terminated by
+ * whitespace or by the end of input, which is signaled with finish.
+ */
+template <typename codec_type>
+class incremental_decoder final {
+ public:
+  using object_type = typename codec_type::object_type;
+
+  explicit incremental_decoder(codec_type codec = default_codec<object_type>())
+      : _codec(std::move(codec)) {}
+
+  /**
+   * Decode the values that end in a chunk of input. The chunk does not need to
+   * outlive the call.
+   *
+   * @throws decode_exception if the brackets of a value do not match, once the
+   *     values before it have been taken.
+   * @return decode_status::ready if a decoded value is queued.
+   */
+  decode_status feed(const char *data, size_t size) {
+    if (!_error && !_finished) {
+      try {
+        feed_chunk(data, data + size);
+      } catch (decode_exception &exception) {
+        const auto offset = _consumed + exception.offset();
+        _error.emplace(std::move(exception), offset);
+      }
+    }
+    return status();
+  }
+
+  decode_status feed(const std::string &data) {
+    return feed(data.data(), data.size());
+  }
+
+  /**
+   * Signal that there is no more input.
+   *
+   * @throws decode_exception if the input ends inside of a value, once the
+   *     values before it have been taken.
+   * @return decode_status::ready if a decoded value is queued, and
+   *     decode_status::done if no input is left.
+   */
+  decode_status finish() {
+    if (!_error && !_finished) {
+      _finished = true;
+      try {
+        if (_scanner.finish()) {
+          decode_value(_buffer.data(), _buffer.data() + _buffer.size());
+        }
+      } catch (decode_exception &exception) {
+        const auto offset = _consumed + exception.offset();
+        _error.emplace(std::move(exception), offset);
+      }
+      _buffer.clear();
+    }
+    return status();
+  }
+
+  /**
+   * @throws decode_exception if the brackets of the value do not match.
+   */
+  decode_status status() const {
+    if (!_decoded.empty()) {
+      return decode_status::ready;
+    } else if (json_unlikely(_error.has_value())) {
+      throw *_error;
+    }
+    return (_finished ? decode_status::done : decode_status::need_more_data);
+  }
+
+  /**
+   * Take the next decoded value. Must only be called when the status is
+   * decode_status::ready.
+   *
+   * @throws decode_exception if the value could not be decoded, with the
+   *     offset of the error counted from the beginning of the input. Decoding
+   *     can continue with the next value.
+   */
+  object_type next() {
+    if (json_unlikely(status() != decode_status::ready)) {
+      throw decode_exception("No complete value is buffered", _consumed);
+    }
+
+    auto decoded = std::move(_decoded.front());
+    _decoded.pop_front();
+    if (json_unlikely(decoded.index() == 1)) {
+      throw std::get<1>(std::move(decoded));
+    }
+    return std::get<0>(std::move(decoded));
+  }
+
+ private:
+  void feed_chunk(const char *position, const char *end) {
+    if (!_buffer.empty()) {
+      // Complete the value that the previous chunk ended in, which is the only
+      // input that is copied.
+      const auto value_end = _scanner.scan(position, end);
+      _buffer.insert(_buffer.end(), position, value_end ? value_end : end);
+      if (!value_end) {
+        return;
+      }
+
+      position = value_end;
+      decode_value(_buffer.data(), _buffer.data() + _buffer.size());
+
+      // Keep the decoded input until the next call, for values that refer to
+      // it, and reuse the memory of the input that was decoded before it.
+      _buffer.swap(_decoded_buffer);
+      _buffer.clear();
+    }
+
+    while (position != end) {
+      const auto value_end = _scanner.scan(position, end);
+      if (!value_end) {
+        _buffer.assign(position, end);
+        return;
+      }
+
+      decode_value(position, value_end);
+      position = value_end;
+    }
+  }
+
+  /**
+   * Decode the value in [begin, end) and queue it, or the error if it can not
+   * be decoded, so that the values after it can still be taken.
+   */
+  void decode_value(const char *begin, const char *end) {
+    const auto consumed = _consumed;
+    _consumed += (end - begin);
+    _scanner.reset();
+
+    try {
+      decode_context context(begin, end);
+      detail::skip_any_whitespace(context);
+      auto value = _codec.decode(context);
+      detail::skip_any_whitespace(context);
+      detail::fail_if(context, context.position != context.end, "Unexpected trailing input");
+      _decoded.emplace_back(std::in_place_index<0>, std::move(value));
+    } catch (decode_exception &exception) {
+      const auto offset = consumed + exception.offset();
+      _decoded.emplace_back(std::in_place_index<1>, decode_exception(std::move(exception), offset));
+    }
+  }
+
+  codec_type _codec;
+  detail::value_scanner _scanner;
+  std::vector<char> _buffer;  // the input since the end of the last value
+  std::vector<char> _decoded_buffer;  // the last value that was decoded from _buffer
+  std::deque<std::variant<object_type, decode_exception>> _decoded;
+  std::optional<decode_exception> _error;  // thrown once _decoded is empty
+  size_t _consumed = 0;  // bytes of input before _buffer
+  bool _finished = false;
+};
+
+}  // namespace json
+}  // namespace spotify
@@ -16,12 +16,23 @@
 
 #pragma once
 
+#include <spotify/json/array_elements.hpp>
 #include <spotify/json/codec.hpp>
+#include <spotify/json/cursor.hpp>
 #include <spotify/json/decode.hpp>
+#include <spotify/json/decode_batch.hpp>
 #include <spotify/json/decode_exception.hpp>
+#include <spotify/json/decode_file.hpp>
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_stream.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/document.hpp>
 #include <spotify/json/encode.hpp>
 #include <spotify/json/encode_exception.hpp>
 #include <spotify/json/encode_context.hpp>
+#include <spotify/json/encode_range.hpp>
 #include <spotify/json/encoded_value.hpp>
+#include <spotify/json/extract.hpp>
+#include <spotify/json/incremental_decoder.hpp>
+#include <spotify/json/mapped_file.hpp>
+#include <spotify/json/parse.hpp>
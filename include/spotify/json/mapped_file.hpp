@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <spotify/json/encoded_value.hpp>
+
+namespace spotify {
+namespace json {
+
+struct mapped_file_options {
+  /**
+   * Tell the kernel that the file is read from front to back, so that it reads
+   * ahead aggressively and drops pages behind the reader (MADV_SEQUENTIAL).
+   */
+  bool sequential = true;
+
+  /**
+   * Start reading the whole file in the background right away (MADV_WILLNEED).
+   */
+  bool will_need = true;
+
+  /**
+   * Read the whole file and map all of its pages before the mapping is returned
+   * (MAP_POPULATE, on Linux), so that decoding never waits for page faults.
+   */
+  bool populate = false;
+
+  /**
+   * Ask for the mapping to be backed by transparent huge pages (MADV_HUGEPAGE,
+   * on Linux), which reduces TLB misses on very large files. The kernel only
+   * honors this for file mappings when it is configured to.
+   */
+  bool huge_pages = false;
+};
+
+/**
+ * A read-only memory mapping of a whole file. On platforms without mmap, the
+ * file is read into a heap buffer instead.
+ */
+class mapped_file final {
+ public:
+  /**
+   * @throws std::system_error if the file can not be opened or mapped.
+   */
+  explicit mapped_file(const std::string &path, const mapped_file_options &options = mapped_file_options());
+  mapped_file(mapped_file &&file) noexcept;
+  mapped_file &operator=(mapped_file &&file) noexcept;
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+  ~mapped_file();
+
+  const char *data() const { return _data; }
+  std::size_t size() const { return _size; }
+
+  void swap(mapped_file &file) noexcept;
+
+ private:
+  void unmap() noexcept;
+
+  const char *_data = "";
+  std::size_t _size = 0;
+  bool _mapped = false;
+};
+
+/**
+ * An encoded_value that is backed by a memory mapped file instead of a copy on
+ * the heap. The JSON in the file is validated when it is mapped.
+ */
+class mapped_encoded_value final : public detail::encoded_value_base {
+ public:
+  /**
+   * @throws std::system_error if the file can not be opened or mapped.
+   * @throws decode_exception if the file does not hold one valid JSON value.
+   */
+  explicit mapped_encoded_value(const std::string &path, const mapped_file_options &options = mapped_file_options());
+  explicit mapped_encoded_value(const std::string &path, const mapped_file_options &options, const unsafe_unchecked &);
+
+  const char *data() const { return _file.data(); }
+  std::size_t size() const { return _file.size(); }
+
+  operator encoded_value_ref() const {
+    return encoded_value_ref(data(), size(), unsafe_unchecked());
+  }
+
+ private:
+  mapped_file _file;
+};
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/detail/stack.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A handler for json::parse that accepts every event and does nothing. Derive
+ * from it to only implement the events that are of interest. The methods are
+ * not virtual; parse calls the methods of the handler type that it is given.
+ *
+ * Every method returns true to continue parsing, or false to stop. Strings and
+ * keys are passed as views of the characters between their quotes in the
+ * input, with escape sequences left as they are; numbers are passed as views
+ * of their (validated) text in the input.
+ */
+struct parse_handler {
+  bool start_object() { return true; }
+  bool key(std::string_view) { return true; }
+  bool end_object() { return true; }
+  bool start_array() { return true; }
+  bool end_array() { return true; }
+  bool string(std::string_view) { return true; }
+  bool number_raw(std::string_view) { return true; }
+  bool boolean(bool) { return true; }
+  bool null() { return true; }
+};
+
+namespace detail {
+
+template <typename handler_type>
+json_force_inline bool parse_key(decode_context &context, handler_type &handler) {
+  skip_any_whitespace(context);
+  fail_if(context, peek(context) != '"', "Expected '\"'");
+  const auto begin = context.position + 1;
+  skip_string(context);
+  if (json_unlikely(!handler.key(std::string_view(begin, context.position - 1 - begin)))) {
+    return false;
+  }
+  skip_any_whitespace(context);
+  skip_1(context, ':');
+  return true;
+}
+
+template <typename handler_type>
+json_force_inline bool parse_scalar(decode_context &context, handler_type &handler) {
+  const auto begin = context.position;
+  switch (peek(context)) {
+    case '"':
+      skip_string(context);
+      return handler.string(std::string_view(begin + 1, context.position - 2 - begin));
+    case '-':  // fallthrough
+    case '0': case '1': case '2': case '3': case '4':  // fallthrough
+    case '5': case '6': case '7': case '8': case '9':
+      skip_number(context);
+      return handler.number_raw(std::string_view(begin, context.position - begin));
+    case 't': skip_true(context); return handler.boolean(true);
+    case 'f': skip_false(context); return handler.boolean(false);
+    case 'n': skip_null(context); return handler.null();
+    default:
+      fail_if(context, !context.remaining(), "Unexpected end of input");
+      fail(context, (std::string("Encountered token '") + peek(context) + "'").c_str());
+  }
+}
+
+/**
+ * Parse one JSON value at context.position and call the handler for each of
+ * its events. Returns false if the handler stopped the parse.
+ */
+template <typename handler_type>
+bool parse_value(decode_context &context, handler_type &handler) {
+  // Like skip_value, the first 64 nesting levels are tracked without heap
+  // allocations. inside is the bracket of the innermost open container.
+  detail::stack<char, 64> stack;
+  char inside = 0;
+
+  while (true) {
+    skip_any_whitespace(context);
+    const auto c = peek(context);
+    if (c == '{' || c == '[') {
+      skip_unchecked_1(context);
+      if (json_unlikely(!(c == '{' ? handler.start_object() : handler.start_array()))) {
+        return false;
+      }
+
+      skip_any_whitespace(context);
+      if (peek(context) != char(c + 2)) {  // '{' + 2 == '}', '[' + 2 == ']'
+        stack.push(inside);
+        inside = c;
+        if (c == '{' && json_unlikely(!parse_key(context, handler))) {
+          return false;
+        }
+        continue;
+      }
+
+      skip_unchecked_1(context);
+      if (json_unlikely(!(c == '{' ? handler.end_object() : handler.end_array()))) {
+        return false;
+      }
+    } else if (json_unlikely(!parse_scalar(context, handler))) {
+      return false;
+    }
+
+    // A value has ended. Close all containers that end right after it.
+    while (true) {
+      if (!inside) {
+        return true;
+      }
+
+      skip_any_whitespace(context);
+      const auto n = next(context, inside == '{' ? "Expected '}'" : "Expected ']'");
+      if (n == ',') {
+        if (inside == '{' && json_unlikely(!parse_key(context, handler))) {
+          return false;
+        }
+        break;
+      }
+
+      fail_if(context, n != char(inside + 2), inside == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'", -1);
+      if (json_unlikely(!(inside == '{' ? handler.end_object() : handler.end_array()))) {
+        return false;
+      }
+      inside = stack.pop();
+    }
+  }
+}
+
+}  // namespace detail
+
+/*
+ * json::parse(handler, data...)
+ *
+ * Parse one JSON value, SAX style: instead of decoding the value into an
+ * object, call the methods of the handler (see parse_handler) for each token
+ * of the value, in order. Nothing is allocated, except for the nesting stack
+ * of values that are nested more than 64 levels deep. Returns true when the
+ * whole input was parsed, and false when the handler stopped the parse early.
+ *
+ * @throws decode_exception if the input is not valid JSON. The handler may
+ *     have been called for the tokens before the error.
+ */
+
+template <typename handler_type>
+bool parse(handler_type &handler, const char *data, size_t size) {
+  decode_context c(data, data + size);
+  detail::skip_any_whitespace(c);
+  if (!detail::parse_value(c, handler)) {
+    return false;
+  }
+  detail::skip_any_whitespace(c);
+  detail::fail_if(c, c.position != c.end, "Unexpected trailing input");
+  return true;
+}
+
+template <typename handler_type>
+bool parse(handler_type &handler, const char *cstr) {
+  return parse(handler, cstr, cstr ? std::strlen(cstr) : 0);
+}
+
+template <typename handler_type, typename string_type>
+bool parse(handler_type &handler, const string_type &string) {
+  return parse(handler, string.data(), string.size());
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/codec/document.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+
+document_t::object_type document_t::decode(decode_context &context) const {
+  return object_type(context);
+}
+
+void document_t::encode(encode_context &context, const object_type &value) const {
+  const auto json = value.root().json();
+  context.append(json.data(), json.size());
+}
+
+}  // namespace codec
+}  // namespace json
+}  // namespace spotify
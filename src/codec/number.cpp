@@ -16,14 +16,341 @@
 
 #include <spotify/json/codec/number.hpp>
 
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 #include <double-conversion/double-conversion.h>
+#include <spotify/json/detail/swar.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif  // _MSC_VER
+
+#include "../detail/power_of_five.hpp"
 
 namespace spotify {
 namespace json {
 namespace detail {
 
-float decode_float(decode_context &context) {
+namespace {
+
+/**
+ * The parameters of the IEEE 754 binary formats for the Eisel-Lemire
+ * algorithm and the Clinger fast path. Powers of ten below the smallest power
+ * round to zero and powers above the largest power round to infinity for any
+ * 19 digit mantissa.
+ */
+template <typename T>
+struct binary_format;
+
+template <>
+struct binary_format<double> {
+  using bits_type = uint64_t;
+  static constexpr int mantissa_bits = 52;
+  static constexpr int minimum_exponent = -1023;
+  static constexpr int infinite_power = 0x7FF;
+  static constexpr int smallest_power_of_ten = -342;
+  static constexpr int largest_power_of_ten = 308;
+  static constexpr int min_exponent_round_to_even = -4;
+  static constexpr int max_exponent_round_to_even = 23;
+  static constexpr int max_exact_power_of_ten = 22;
+  static constexpr uint64_t max_exact_mantissa = uint64_t(1) << 53;
+
+  static double exact_power_of_ten(const int exponent) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    return powers[exponent];
+  }
+};
+
+template <>
+struct binary_format<float> {
+  using bits_type = uint32_t;
+  static constexpr int mantissa_bits = 23;
+  static constexpr int minimum_exponent = -127;
+  static constexpr int infinite_power = 0xFF;
+  static constexpr int smallest_power_of_ten = -64;
+  static constexpr int largest_power_of_ten = 38;
+  static constexpr int min_exponent_round_to_even = -17;
+  static constexpr int max_exponent_round_to_even = 10;
+  static constexpr int max_exact_power_of_ten = 10;
+  static constexpr uint64_t max_exact_mantissa = uint64_t(1) << 24;
+
+  static float exact_power_of_ten(const int exponent) {
+    static const float powers[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+    return powers[exponent];
+  }
+};
+
+// The Clinger fast path relies on every operation being rounded once, in the
+// precision of its type, which is not the case with x87 extended precision.
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+constexpr bool has_exact_float_arithmetic = true;
+#else
+constexpr bool has_exact_float_arithmetic = false;
+#endif
+
+struct uint128 {
+  uint64_t low;
+  uint64_t high;
+};
+
+json_force_inline uint128 full_multiplication(const uint64_t a, const uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<unsigned __int128>(a) * b;
+  return uint128{ uint64_t(product), uint64_t(product >> 64) };
+#elif defined(_MSC_VER) && defined(_M_X64)
+  uint64_t high;
+  const uint64_t low = _umul128(a, b, &high);
+  return uint128{ low, high };
+#else
+  const uint64_t a_lo = uint32_t(a), a_hi = (a >> 32);
+  const uint64_t b_lo = uint32_t(b), b_hi = (b >> 32);
+  const uint64_t lo_lo = a_lo * b_lo;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t lo_hi = a_lo * b_hi;
+  const uint64_t cross = (lo_lo >> 32) + uint32_t(hi_lo) + lo_hi;
+  return uint128{ (cross << 32) | uint32_t(lo_lo), a_hi * b_hi + (hi_lo >> 32) + (cross >> 32) };
+#endif
+}
+
+json_force_inline int count_leading_zeros(const uint64_t value) {
+#if defined(__GNUC__)
+  return __builtin_clzll(value);
+#else
+  int count = 0;
+  for (auto v = value; !(v & (uint64_t(1) << 63)); v <<= 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+/**
+ * The Eisel-Lemire algorithm: compute the bits of the float that is nearest
+ * to w * 10^q, with w != 0 and q within the range of the format, from a 128
+ * bit approximation of w * 5^q. Returns false in the rare cases where the
+ * approximation is not precise enough to decide how to round.
+ */
+template <typename T>
+bool eisel_lemire(uint64_t w, const int64_t q, uint64_t &bits) {
+  using format = binary_format<T>;
+
+  const auto lz = count_leading_zeros(w);
+  w <<= lz;
+
+  const auto index = 2 * size_t(q - smallest_power_of_five);
+  const auto precision_mask = (~uint64_t(0) >> (format::mantissa_bits + 3));
+  auto product = full_multiplication(w, power_of_five_128[index]);
+  if ((product.high & precision_mask) == precision_mask) {
+    const auto second = full_multiplication(w, power_of_five_128[index + 1]);
+    product.low += second.high;
+    product.high += (second.high > product.low);
+  }
+  if (json_unlikely(product.low == ~uint64_t(0) && (q < -27 || q > 55))) {
+    return false;
+  }
+
+  const auto upper_bit = int(product.high >> 63);
+  const auto shift = upper_bit + 64 - format::mantissa_bits - 3;
+  auto mantissa = (product.high >> shift);
+  auto power2 = int(((217706 * q) >> 16) + 63) + upper_bit - lz - format::minimum_exponent;
+
+  if (power2 <= 0) {
+    // The result is subnormal, or rounds up to the smallest normal number.
+    if (-power2 + 1 >= 64) {
+      bits = 0;
+      return true;
+    }
+    mantissa >>= -power2 + 1;
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    power2 = (mantissa < (uint64_t(1) << format::mantissa_bits) ? 0 : 1);
+    bits = mantissa | (uint64_t(power2) << format::mantissa_bits);
+    return true;
+  }
+
+  // Exactly halfway between two floats: round to even instead of up.
+  if (product.low <= 1 &&
+      q >= format::min_exponent_round_to_even &&
+      q <= format::max_exponent_round_to_even &&
+      (mantissa & 3) == 1 &&
+      (mantissa << shift) == product.high) {
+    mantissa &= ~uint64_t(1);
+  }
+
+  mantissa += (mantissa & 1);
+  mantissa >>= 1;
+  if (mantissa >= (uint64_t(2) << format::mantissa_bits)) {
+    mantissa = (uint64_t(1) << format::mantissa_bits);
+    power2++;
+  }
+  mantissa &= ~(uint64_t(1) << format::mantissa_bits);
+
+  if (power2 >= format::infinite_power) {
+    power2 = format::infinite_power;
+    mantissa = 0;
+  }
+  bits = mantissa | (uint64_t(power2) << format::mantissa_bits);
+  return true;
+}
+
+/**
+ * Convert w * 10^q to the nearest float. Returns false if this needs to be
+ * left to double-conversion.
+ */
+template <typename T>
+json_force_inline bool decimal_to_binary(const uint64_t w, const int64_t q, T &value) {
+  using format = binary_format<T>;
+
+  if (!w || q < format::smallest_power_of_ten) {
+    value = T(0);
+    return true;
+  }
+
+  // Clinger: w and 10^|q| are both exact, so one multiplication or division
+  // rounds correctly.
+  if (has_exact_float_arithmetic &&
+      q >= -format::max_exact_power_of_ten &&
+      q <= format::max_exact_power_of_ten &&
+      w <= format::max_exact_mantissa) {
+    value = T(w);
+    if (q < 0) {
+      value /= format::exact_power_of_ten(int(-q));
+    } else {
+      value *= format::exact_power_of_ten(int(q));
+    }
+    return true;
+  }
+
+  if (q > format::largest_power_of_ten) {
+    value = std::numeric_limits<T>::infinity();
+    return true;
+  }
+
+  uint64_t bits;
+  if (json_unlikely(!eisel_lemire<T>(w, q, bits))) {
+    return false;
+  }
+  const auto binary = typename format::bits_type(bits);
+  std::memcpy(&value, &binary, sizeof(value));
+  return true;
+}
+
+json_force_inline bool is_digit(const char c) {
+  return (c >= '0' && c <= '9');
+}
+
+/**
+ * Accumulate the decimal digits at p into w, 8 at a time while possible, and
+ * return the end of the digits.
+ */
+json_force_inline const char *scan_digits(const char *p, const char *end, uint64_t &w) {
+  while (end - p >= 8) {
+    const auto chunk = load_le_8(p);
+    if (!is_eight_digits(chunk)) {
+      break;
+    }
+    w = w * 100000000 + parse_eight_digits(chunk);
+    p += 8;
+  }
+  for (; p != end && is_digit(*p); ++p) {
+    w = w * 10 + uint64_t(*p - '0');
+  }
+  return p;
+}
+
+/**
+ * A number of the form '-'? digits ('.' digits)? ([eE] [+-]? digits)?, as
+ * w * 10^q, where w has at most 19 significant digits.
+ */
+struct decimal {
+  uint64_t w;
+  int64_t q;
+  bool negative;
+  const char *end;
+};
+
+/**
+ * Scan the number at p. Returns false for everything that is not of the form
+ * above, including numbers with more than 19 significant digits; these are
+ * rare and are left to double-conversion.
+ */
+json_force_inline bool scan_decimal(const char *p, const char *end, decimal &number) {
+  number.negative = (p != end && *p == '-');
+  p += number.negative;
+  if (json_unlikely(p == end || !is_digit(*p))) {
+    return false;
+  }
+
+  uint64_t w = 0;
+  const auto int_begin = p;
+  p = scan_digits(p, end, w);
+  auto num_digits = (p - int_begin);
+
+  int64_t q = 0;
+  if (p != end && *p == '.') {
+    const auto frac_begin = ++p;
+    p = scan_digits(p, end, w);
+    if (json_unlikely(p == frac_begin)) {
+      return false;
+    }
+    q = -(p - frac_begin);
+    num_digits += (p - frac_begin);
+  }
+
+  if (json_unlikely(num_digits > 19)) {
+    // Leading zeros do not contribute to w, so only they may be discounted.
+    auto num_zeros = 0;
+    for (auto s = int_begin; s != p && (*s == '0' || *s == '.'); ++s) {
+      num_zeros += (*s == '0');
+    }
+    if (num_digits - num_zeros > 19) {
+      return false;
+    }
+  }
+
+  if (p != end && (*p | 0x20) == 'e') {
+    ++p;
+    const auto negative_exponent = (p != end && *p == '-');
+    p += (p != end && (*p == '-' || *p == '+'));
+    if (json_unlikely(p == end || !is_digit(*p))) {
+      return false;
+    }
+
+    int64_t exponent = 0;
+    for (; p != end && is_digit(*p); ++p) {
+      if (json_unlikely(exponent >= 100000000)) {
+        return false;
+      }
+      exponent = exponent * 10 + (*p - '0');
+    }
+    q += (negative_exponent ? -exponent : exponent);
+  }
+
+  number.w = w;
+  number.q = q;
+  number.end = p;
+  return true;
+}
+
+template <typename T>
+json_force_inline bool decode_fast(decode_context &context, T &value) {
+  decimal number;
+  if (!scan_decimal(context.position, context.end, number) ||
+      !decimal_to_binary(number.w, number.q, value)) {
+    return false;
+  }
+  value = (number.negative ? -value : value);
+  context.position = number.end;
+  return true;
+}
+
+const double_conversion::StringToDoubleConverter &string_to_double_converter() {
   using atod_converter = double_conversion::StringToDoubleConverter;
   static const atod_converter converter(
       atod_converter::ALLOW_TRAILING_JUNK,
@@ -31,74 +358,333 @@ float decode_float(decode_context &context) {
       std::numeric_limits<double>::quiet_NaN(),
       nullptr,
       nullptr);
+  return converter;
+}
+
+/**
+ * A finite, non-zero float as digits * 10^exponent, with the fewest digits
+ * that decode back to the same float; of several such numbers, the one that
+ * is closest to it.
+ */
+struct shortest_decimal {
+  uint64_t digits;
+  int exponent;
+};
+
+// ceil(log2(5^e)) for 1 <= e <= 3528, and 1 for e == 0.
+json_force_inline int pow5_bits(const int e) {
+  return int((uint32_t(e) * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e)) for 0 <= e <= 1650.
+json_force_inline int log10_pow2(const int e) {
+  return int((uint32_t(e) * 78913) >> 18);
+}
+
+// floor(log10(5^e)) for 0 <= e <= 2620.
+json_force_inline int log10_pow5(const int e) {
+  return int((uint32_t(e) * 732923) >> 20);
+}
+
+json_force_inline bool is_multiple_of_power_of_5(uint64_t value, const int p) {
+  auto count = 0;
+  for (; value % 5 == 0; value /= 5) {
+    count++;
+  }
+  return count >= p;
+}
+
+json_force_inline bool is_multiple_of_power_of_2(const uint64_t value, const int p) {
+  return !(value & ((uint64_t(1) << p) - 1));
+}
+
+/**
+ * (m * factor) >> shift, where factor is a 125 bit table entry with the high
+ * half first, and 64 < shift < 128.
+ */
+json_force_inline uint64_t multiply_shift(const uint64_t m, const uint64_t *factor, const int shift) {
+  const auto low = full_multiplication(m, factor[1]);
+  const auto high = full_multiplication(m, factor[0]);
+  const uint64_t sum_low = high.low + low.high;
+  const uint64_t sum_high = high.high + (sum_low < high.low);
+  return (sum_high << (128 - shift)) | (sum_low >> (shift - 64));
+}
+
+/**
+ * The Ryu algorithm: find the shortest decimal in the interval of numbers
+ * that round to value, by computing the interval bounds and its midpoint in
+ * decimal with just enough precision, and then removing digits for as long
+ * as the bounds still differ.
+ */
+template <typename T>
+shortest_decimal to_shortest_decimal(const T value) {
+  using format = binary_format<T>;
+
+  typename format::bits_type bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint64_t ieee_mantissa = bits & ((typename format::bits_type(1) << format::mantissa_bits) - 1);
+  const int ieee_exponent = int((bits >> format::mantissa_bits) & format::infinite_power);
+
+  // The float is m2 * 2^(e2 + 2); the extra factor 4 makes the bounds of its
+  // interval, halfway to the neighbouring floats, integers too.
+  int e2;
+  uint64_t m2;
+  if (ieee_exponent == 0) {
+    e2 = 1 + format::minimum_exponent - format::mantissa_bits - 2;
+    m2 = ieee_mantissa;
+  } else {
+    e2 = ieee_exponent + format::minimum_exponent - format::mantissa_bits - 2;
+    m2 = (uint64_t(1) << format::mantissa_bits) | ieee_mantissa;
+  }
+  const bool accept_bounds = !(m2 & 1);
+  const uint64_t mv = 4 * m2;
+
+  // The lower bound is closer when m2 is a power of two.
+  const uint64_t mm_shift = (ieee_mantissa != 0 || ieee_exponent <= 1);
+
+  // The midpoint and the bounds times 10^-e10, and whether the digits that
+  // are dropped to get there are all zero.
+  uint64_t vr, vp, vm;
+  int e10;
+  bool vm_is_trailing_zeros = false;
+  bool vr_is_trailing_zeros = false;
+  if (e2 >= 0) {
+    const int q = log10_pow2(e2) - (e2 > 3);
+    const int shift = -e2 + q + pow5_bits(q) - 1 + 125;
+    const auto factor = &inverse_power_of_five_125[2 * q];
+    e10 = q;
+    vr = multiply_shift(mv, factor, shift);
+    vp = multiply_shift(mv + 2, factor, shift);
+    vm = multiply_shift(mv - 1 - mm_shift, factor, shift);
+    if (q <= 21) {
+      // At most one of mv, mp and mm is a multiple of 5, and only powers of
+      // 5 up to 5^21 can divide any of them.
+      if (mv % 5 == 0) {
+        vr_is_trailing_zeros = is_multiple_of_power_of_5(mv, q);
+      } else if (accept_bounds) {
+        vm_is_trailing_zeros = is_multiple_of_power_of_5(mv - 1 - mm_shift, q);
+      } else {
+        vp -= is_multiple_of_power_of_5(mv + 2, q);
+      }
+    }
+  } else {
+    const int q = log10_pow5(-e2) - (-e2 > 1);
+    const int i = -e2 - q;
+    const int shift = q - pow5_bits(i) + 125;
+    const auto factor = &power_of_five_125[2 * i];
+    e10 = q + e2;
+    vr = multiply_shift(mv, factor, shift);
+    vp = multiply_shift(mv + 2, factor, shift);
+    vm = multiply_shift(mv - 1 - mm_shift, factor, shift);
+    if (q <= 1) {
+      // mv, mp and mm all have at least q trailing zero bits, and mp is
+      // divisible by 10^q exactly when mv is.
+      vr_is_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_is_trailing_zeros = (mm_shift == 1);
+      } else {
+        --vp;
+      }
+    } else if (q < 63) {
+      vr_is_trailing_zeros = is_multiple_of_power_of_2(mv, q);
+    }
+  }
+
+  // Remove digits for as long as the bounds differ, and round the midpoint
+  // on the last removed digit.
+  auto removed = 0;
+  uint64_t output;
+  if (json_unlikely(vm_is_trailing_zeros || vr_is_trailing_zeros)) {
+    uint8_t last_removed_digit = 0;
+    for (; vp / 10 > vm / 10; removed++) {
+      vm_is_trailing_zeros &= (vm % 10 == 0);
+      vr_is_trailing_zeros &= (last_removed_digit == 0);
+      last_removed_digit = uint8_t(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    if (vm_is_trailing_zeros) {
+      for (; vm % 10 == 0; removed++) {
+        vr_is_trailing_zeros &= (last_removed_digit == 0);
+        last_removed_digit = uint8_t(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+      }
+    }
+    if (vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+      last_removed_digit = 4;  // Exactly halfway: round to even.
+    }
+    output = vr + ((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5);
+  } else {
+    bool round_up = false;
+    if (vp / 100 > vm / 100) {
+      round_up = (vr % 100 >= 50);
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      removed += 2;
+    }
+    for (; vp / 10 > vm / 10; removed++) {
+      round_up = (vr % 10 >= 5);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    output = vr + (vr == vm || round_up);
+  }
+
+  return shortest_decimal{ output, e10 + removed };
+}
+
+json_force_inline int count_digits(const uint64_t value) {
+  auto num_digits = 1;
+  for (uint64_t power = 10; num_digits < 20 && value >= power; power *= 10) {
+    num_digits++;
+  }
+  return num_digits;
+}
+
+/**
+ * Write the num_digits decimal digits of value to p, two at a time.
+ */
+json_force_inline void write_digits(char *p, uint64_t value, int num_digits) {
+  static const char digit_pairs[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  for (; num_digits >= 2; value /= 100) {
+    num_digits -= 2;
+    std::memcpy(p + num_digits, &digit_pairs[2 * (value % 100)], 2);
+  }
+  if (num_digits) {
+    p[0] = char('0' + value);
+  }
+}
+
+/**
+ * Write a shortest decimal the way ECMAScript's Number.prototype.toString
+ * does, which is the format that spotify-json has always written numbers in:
+ * decimal notation when there are at most 21 digits before the decimal point
+ * and at most 5 zeros after it, and exponential notation with an explicit
+ * exponent sign otherwise. Returns the end of what was written.
+ */
+char *write_shortest_decimal(char *p, const shortest_decimal decimal, const bool negative) {
+  if (negative) {
+    *p++ = '-';
+  }
+
+  const auto num_digits = count_digits(decimal.digits);
+  const auto point = num_digits + decimal.exponent;
+  if (point > -6 && point <= 21) {
+    if (point <= 0) {
+      // 0.000ddd
+      p[0] = '0';
+      p[1] = '.';
+      std::memset(p + 2, '0', size_t(-point));
+      write_digits(p + 2 - point, decimal.digits, num_digits);
+      return p + 2 - point + num_digits;
+    } else if (point >= num_digits) {
+      // ddd000
+      write_digits(p, decimal.digits, num_digits);
+      std::memset(p + num_digits, '0', size_t(point - num_digits));
+      return p + point;
+    } else {
+      // dd.ddd
+      write_digits(p + 1, decimal.digits, num_digits);
+      std::memmove(p, p + 1, size_t(point));
+      p[point] = '.';
+      return p + num_digits + 1;
+    }
+  }
+
+  // d.dddde+xx
+  write_digits(p + 1, decimal.digits, num_digits);
+  p[0] = p[1];
+  if (num_digits > 1) {
+    p[1] = '.';
+    p += num_digits + 1;
+  } else {
+    p += 1;
+  }
+  const auto exponent = point - 1;
+  *p++ = 'e';
+  *p++ = (exponent < 0 ? '-' : '+');
+  const auto magnitude = uint64_t(exponent < 0 ? -exponent : exponent);
+  const auto num_exponent_digits = count_digits(magnitude);
+  write_digits(p, magnitude, num_exponent_digits);
+  return p + num_exponent_digits;
+}
+
+template <typename T>
+json_force_inline void encode_shortest(encode_context &context, const T value) {
+  using format = binary_format<T>;
+  using integer_type = typename std::conditional<sizeof(T) == sizeof(int32_t), int32_t, int64_t>::type;
+
+  // Integers up to the largest exactly representable one are their own
+  // shortest representation, and are written by the faster integer encoder.
+  // This includes zero, which is always written without its sign.
+  if (std::abs(value) <= T(format::max_exact_mantissa)) {
+    const auto integer = integer_type(value);
+    if (json_likely(T(integer) == value)) {
+      if (integer < 0) {
+        encode_negative_integer(context, integer);
+      } else {
+        encode_positive_integer(context, integer);
+      }
+      return;
+    }
+  }
+
+  detail::fail_if(context, !std::isfinite(value), "Special values like 'Infinity' or 'NaN' are supported in JSON.");
+
+  // The longest possible output is '-0.00000' followed by 17 digits.
+  const auto max_required_size = 25;
+  const auto p = context.reserve(max_required_size);
+  const auto end = write_shortest_decimal(p, to_shortest_decimal(value), std::signbit(value));
+  context.advance(size_t(end - p));
+}
+
+}  // namespace
+
+float decode_float(decode_context &context) {
+  float result;
+  if (json_likely(decode_fast(context, result))) {
+    return result;
+  }
 
   int bytes_read = 0;
   auto remaining = static_cast<int>(context.end - context.position);
-  auto result = converter.StringToFloat(context.position, remaining, &bytes_read);
+  result = string_to_double_converter().StringToFloat(context.position, remaining, &bytes_read);
   fail_if(context, std::isnan(result), "Invalid floating point number");
   skip_unchecked_n(context, bytes_read);
   return result;
 }
 
 double decode_double(decode_context &context) {
-  using atod_converter = double_conversion::StringToDoubleConverter;
-  static const atod_converter converter(
-      atod_converter::ALLOW_TRAILING_JUNK,
-      std::numeric_limits<double>::quiet_NaN(),
-      std::numeric_limits<double>::quiet_NaN(),
-      nullptr,
-      nullptr);
+  double result;
+  if (json_likely(decode_fast(context, result))) {
+    return result;
+  }
 
   int bytes_read = 0;
   auto remaining = static_cast<int>(context.end - context.position);
-  auto result = converter.StringToDouble(context.position, remaining, &bytes_read);
+  result = string_to_double_converter().StringToDouble(context.position, remaining, &bytes_read);
   fail_if(context, std::isnan(result), "Invalid floating point number");
   skip_unchecked_n(context, bytes_read);
   return result;
 }
 
 void encode_float(encode_context &context, float value) {
-  // The maximum buffer size required to emit a double in base 10, for decimal
-  // and exponential representations, is 25 bytes; based on the settings used
-  // below for the DoubleToStringConverter. We add another byte for the null
-  // terminator, but it is not actually needed because we don't finalize the
-  // builder.
-  const auto max_required_size = 26;
-  const auto p = reinterpret_cast<char *>(context.reserve(max_required_size));
-
-  // The converter is based on the ECMAScript converter, but will not convert
-  // special values, like Infinity and NaN, since JSON does not support those.
-  using dtoa_converter = double_conversion::DoubleToStringConverter;
-  const dtoa_converter converter(
-      dtoa_converter::UNIQUE_ZERO | dtoa_converter::EMIT_POSITIVE_EXPONENT_SIGN,
-      nullptr, nullptr, 'e', -6, 21, 6, 0);
-
-  using dtoa_builder = double_conversion::StringBuilder;
-  dtoa_builder builder(p, max_required_size);
-  detail::fail_if(context, !converter.ToShortest(value, &builder), "Special values like 'Infinity' or 'NaN' are supported in JSON.");
-  context.advance(builder.position());
+  // Floats have always been encoded as the double they convert to, which
+  // keeps all digits of its exact value that a double needs to round trip,
+  // e.g., 0.1f is encoded as 0.10000000149011612.
+  encode_shortest(context, double(value));
 }
 
 void encode_double(encode_context &context, double value) {
-  // The maximum buffer size required to emit a double in base 10, for decimal
-  // and exponential representations, is 25 bytes; based on the settings used
-  // below for the DoubleToStringConverter. We add another byte for the null
-  // terminator, but it is not actually needed because we don't finalize the
-  // builder.
-  const auto max_required_size = 26;
-  const auto p = reinterpret_cast<char *>(context.reserve(max_required_size));
-
-  // The converter is based on the ECMAScript converter, but will not convert
-  // special values, like Infinity and NaN, since JSON does not support those.
-  using dtoa_converter = double_conversion::DoubleToStringConverter;
-  const dtoa_converter converter(
-      dtoa_converter::UNIQUE_ZERO | dtoa_converter::EMIT_POSITIVE_EXPONENT_SIGN,
-      nullptr, nullptr, 'e', -6, 21, 6, 0);
-
-  using dtoa_builder = double_conversion::StringBuilder;
-  dtoa_builder builder(p, max_required_size);
-  detail::fail_if(context, !converter.ToShortest(value, &builder), "Special values like 'Infinity' or 'NaN' are supported in JSON.");
-  context.advance(builder.position());
+  encode_shortest(context, value);
 }
 
 }  // namespace detail
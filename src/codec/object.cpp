@@ -16,39 +16,163 @@
 
 #include <spotify/json/codec/object.hpp>
 
+#include <cstring>
+
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+
 namespace spotify {
 namespace json {
 namespace codec {
 namespace codec_detail {
+namespace {
 
-object_t_base::object_t_base() = default;
-object_t_base::object_t_base(construct_untyped *construct) : _construct(construct) {}
-object_t_base::object_t_base(object_t_base &&) = default;
-object_t_base::object_t_base(const object_t_base &) = default;
-object_t_base::~object_t_base() = default;
+/**
+ * Check if the key at context.position is the escaped key of the field at the
+ * given index, which is stored with quotes and a trailing ':'. The quotes make
+ * the key self-delimiting, so a byte-wise match of everything but the ':' is a
+ * match of the key. On a match, context.position is moved past the key.
+ */
+json_force_inline bool match_escaped_key(
+    decode_context &context,
+    const detail::field_registry &fields,
+    const size_t index) {
+  if (json_unlikely(index >= fields.size())) {
+    return false;
+  }
 
-void object_t_base::decode(decode_context &context, void *value) const {
+  const auto &escaped_key = fields[index].first;
+  const auto quoted_key_size = escaped_key.size() - 1;  // do not include the ':'
+  if (context.remaining() >= quoted_key_size &&
+      std::memcmp(context.position, escaped_key.data(), quoted_key_size) == 0) {
+    context.position += quoted_key_size;
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/**
+ * Parse an object key and return the index of the field with that name, or
+ * json_size_t_max. Keys without escape sequences are looked up directly from
+ * the input buffer; only keys with escape sequences are unescaped into a
+ * string first.
+ */
+json_force_inline size_t decode_key(
+    decode_context &context,
+    const detail::field_registry &fields) {
+  detail::skip_1(context, '"');
+  const auto key_begin = context.position;
+  detail::skip_any_simple_characters(context);
+
+  switch (detail::next(context, "Unterminated string")) {
+    case '"': return fields.find_index(key_begin, context.position - 1 - key_begin);
+    case '\\':
+      context.position = key_begin - 1;
+      return fields.find_index(string_t().decode(context));
+    default: json_unreachable();
+  }
+}
+
+/**
+ * Decode the fields of an object into value. When decoding into an existing
+ * value, the fields are decoded with field::decode_into and the indices of the
+ * decoded fields are marked in seen_fields. Returns the number of unique
+ * fields that were decoded.
+ */
+template <bool into>
+json_force_inline size_t decode_fields(
+    decode_context &context,
+    const detail::field_registry &fields,
+    void *value,
+    detail::bitset_base *seen_fields) {
   uint_fast32_t uniq_seen_required = 0;
-  detail::bitset<64> seen_required(_fields.num_required_fields());
+  size_t uniq_seen = 0;
+  detail::bitset<64> seen_required(fields.num_required_fields());
+
+  // Producers almost always write the fields in the order that they are
+  // declared in, so before hashing a key, guess that it is the key of the
+  // field after the previously decoded field.
+  size_t next_index = 0;
+
+  detail::decode_comma_separated(context, '{', '}', [&]{
+    const auto index = (match_escaped_key(context, fields, next_index) ?
+        next_index :
+        decode_key(context, fields));
 
-  detail::decode_object<string_t>(context, [&](const std::string &key) {
-    const auto *field = _fields.find(key);
-    if (json_unlikely(!field)) {
+    detail::skip_any_whitespace(context);
+    detail::skip_1(context, ':');
+    detail::skip_any_whitespace(context);
+
+    if (json_unlikely(index == json_size_t_max)) {
       return detail::skip_value(context);
     }
 
-    field->decode(context, value);
+    next_index = index + 1;
+    const auto *field = fields[index].second.get();
+    if constexpr (into) {
+      field->decode_into(context, value);
+      uniq_seen += (1 - seen_fields->test_and_set(index));
+    } else {
+      field->decode(context, value);
+    }
     if (field->is_required()) {
       const auto seen = seen_required.test_and_set(field->required_field_idx());
       uniq_seen_required += (1 - seen);  // 'seen' is 1 when the field is a duplicate; 0 otherwise
     }
   });
 
-  const auto is_missing_req_fields = (uniq_seen_required != _fields.num_required_fields());
+  const auto is_missing_req_fields = (uniq_seen_required != fields.num_required_fields());
   detail::fail_if(context, is_missing_req_fields, "Missing required field(s)");
+  return uniq_seen;
+}
+
+}  // namespace
+
+object_t_base::object_t_base() = default;
+object_t_base::object_t_base(construct_untyped *construct) : _construct(construct) {}
+object_t_base::object_t_base(object_t_base &&) = default;
+object_t_base::object_t_base(const object_t_base &) = default;
+object_t_base::~object_t_base() = default;
+
+void object_t_base::decode(decode_context &context, void *value) const {
+  decode_fields<false>(context, _fields, value, nullptr);
+}
+
+size_t object_t_base::decode_into(
+    decode_context &context,
+    void *value,
+    detail::bitset_base &seen_fields) const {
+  return decode_fields<true>(context, _fields, value, &seen_fields);
+}
+
+void object_t_base::reset_unseen(
+    void *value,
+    const void *prototype,
+    const detail::bitset_base &seen_fields) const {
+  for (size_t i = 0; i < _fields.size(); i++) {
+    if (!seen_fields.test(i)) {
+      _fields[i].second->reset(value, prototype);
+    }
+  }
 }
 
 void object_t_base::encode(encode_context &context, const void *value) const {
+  const auto &literals = _fields.encode_literals();
+  if (json_likely(!literals.empty())) {
+    // All fields are always encoded, so the text between the values is known
+    // up front: write each gap with a single append.
+    context.reserve(_fields.encode_size_hint());
+    auto literal = literals.begin();
+    context.append(literal->data(), literal->size());
+    for (const auto &kv : _fields) {
+      kv.second->encode_value(context, value);
+      ++literal;
+      context.append(literal->data(), literal->size());
+    }
+    return;
+  }
+
   context.append('{');
   for (const auto &kv : _fields) {
     const auto &field = *kv.second.get();
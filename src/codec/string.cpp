@@ -16,6 +16,8 @@
 
 #include <spotify/json/codec/string.hpp>
 
+#include <cstring>
+
 #include <spotify/json/decode_exception.hpp>
 #include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/escape.hpp>
@@ -55,7 +57,8 @@ unsigned decode_hex_number(decode_context &context) {
   return unsigned((a << 12) | (b << 8) | (c << 4) | d);
 }
 
-void encode_utf8_4(std::string &out, uint32_t p) {
+template <typename string_type>
+void encode_utf8_4(string_type &out, uint32_t p) {
   const char c0 = 0xF0 | ((p >> 18) & 0x07);
   const char c1 = 0x80 | ((p >> 12) & 0x3F);
   const char c2 = 0x80 | ((p >>  6) & 0x3F);
@@ -64,7 +67,8 @@ void encode_utf8_4(std::string &out, uint32_t p) {
   out.append(&cc[0], 4);
 }
 
-void encode_utf8_3(std::string &out, unsigned p) {
+template <typename string_type>
+void encode_utf8_3(string_type &out, unsigned p) {
   const char c0 = 0xE0 | ((p >> 12) & 0x0F);
   const char c1 = 0x80 | ((p >>  6) & 0x3F);
   const char c2 = 0x80 | ((p >>  0) & 0x3F);
@@ -72,19 +76,22 @@ void encode_utf8_3(std::string &out, unsigned p) {
   out.append(&cc[0], 3);
 }
 
-void encode_utf8_2(std::string &out, unsigned p) {
+template <typename string_type>
+void encode_utf8_2(string_type &out, unsigned p) {
   const char c0 = 0xC0 | ((p >> 6) & 0x1F);
   const char c1 = 0x80 | ((p >> 0) & 0x3F);
   const char cc[] = { c0, c1 };
   out.append(&cc[0], 2);
 }
 
-void encode_utf8_1(std::string &out, unsigned p) {
+template <typename string_type>
+void encode_utf8_1(string_type &out, unsigned p) {
   const char c0 = (p & 0x7F);
   out.push_back(c0);
 }
 
-void encode_utf8(std::string &out, unsigned p) {
+template <typename string_type>
+void encode_utf8(string_type &out, unsigned p) {
   if (json_likely(p <= 0x7F)) {
     encode_utf8_1(out, p);
   } else if (json_likely(p <= 0x07FF)) {
@@ -94,7 +101,8 @@ void encode_utf8(std::string &out, unsigned p) {
   }
 }
 
-bool handle_surrogate_pair(decode_context &context, std::string &out, unsigned p) {
+template <typename string_type>
+bool handle_surrogate_pair(decode_context &context, string_type &out, unsigned p) {
   if (json_unlikely(is_high_surrogate(p))) {
     // Parse low surrogate
     if (detail::peek_2(context, '\\', 'u')) {
@@ -114,14 +122,16 @@ bool handle_surrogate_pair(decode_context &context, std::string &out, unsigned p
   return false;
 }
 
-void decode_unicode_escape(decode_context &context, std::string &out) {
+template <typename string_type>
+void decode_unicode_escape(decode_context &context, string_type &out) {
   const auto p = decode_hex_number(context);
   if (json_likely(!handle_surrogate_pair(context, out, p))) {
     encode_utf8(out, p);
   }
 }
 
-void decode_escape(decode_context &context, std::string &out) {
+template <typename string_type>
+void decode_escape(decode_context &context, string_type &out) {
   const auto escape_character = detail::next(context, "Unterminated string");
   switch (escape_character) {
     case '"':  out.push_back('"');  break;
@@ -137,8 +147,9 @@ void decode_escape(decode_context &context, std::string &out) {
   }
 }
 
-string_t::object_type decode_escaped_string(decode_context &context, const char *begin) {
-  std::string unescaped(begin, context.position - 1);
+template <typename string_type>
+string_type decode_escaped_string(decode_context &context, const char *begin, string_type &&unescaped) {
+  unescaped.assign(begin, context.position - 1);
   decode_escape(context, unescaped);
 
   while (json_likely(context.remaining())) {
@@ -147,7 +158,7 @@ string_t::object_type decode_escaped_string(decode_context &context, const char
     unescaped.append(begin_simple, context.position);
 
     switch (detail::next(context, "Unterminated string")) {
-      case '"': return unescaped;
+      case '"': return std::move(unescaped);
       case '\\': decode_escape(context, unescaped); break;
       default: json_unreachable();
     }
@@ -156,25 +167,82 @@ string_t::object_type decode_escaped_string(decode_context &context, const char
   detail::fail(context, "Unterminated string");
 }
 
-string_t::object_type decode_string(decode_context &context) {
+/**
+ * Decode a string into string_type, replacing its contents but keeping its
+ * capacity and allocator.
+ */
+template <typename string_type>
+string_type decode_string(decode_context &context, string_type &&out) {
   const auto begin_simple = context.position;
   detail::skip_any_simple_characters(context);
 
   switch (detail::next(context, "Unterminated string")) {
-    case '"': return std::string(begin_simple, context.position - 1);
-    case '\\': return decode_escaped_string(context, begin_simple);
+    case '"':
+      out.assign(begin_simple, context.position - 1);
+      return std::move(out);
+    case '\\': return decode_escaped_string(context, begin_simple, std::move(out));
     default: json_unreachable();
   }
 }
 
-}  // namespace
+/**
+ * A string_type for decode_escaped_string that writes into a preallocated
+ * buffer that is known to be large enough.
+ */
+struct unescape_buffer {
+  char *data;
+  size_t size;
 
-string_t::object_type string_t::decode(decode_context &context) const {
-  detail::skip_1(context, '"');
-  return decode_string(context);
+  void assign(const char *begin, const char *end) {
+    size = 0;
+    append(begin, end);
+  }
+
+  void append(const char *begin, const char *end) {
+    append(begin, size_t(end - begin));
+  }
+
+  void append(const char *chars, const size_t num_chars) {
+    std::memcpy(data + size, chars, num_chars);
+    size += num_chars;
+  }
+
+  void push_back(const char c) {
+    data[size++] = c;
+  }
+};
+
+std::string_view decode_string_view(decode_context &context) {
+  const auto begin_simple = context.position;
+  detail::skip_any_simple_characters(context);
+
+  switch (detail::next(context, "Unterminated string")) {
+    case '"': return std::string_view(begin_simple, context.position - begin_simple - 1);
+    case '\\': break;
+    default: json_unreachable();
+  }
+
+  const auto resource = context.memory_resource;
+  detail::fail_if(context, !resource, "Escaped string requires a memory_resource", -1);
+
+  // Find the end of the string without validating it, to allocate a buffer
+  // that the unescaped string, which is never longer, is guaranteed to fit in.
+  decode_context scan(context);
+  while (json_likely(scan.remaining())) {
+    detail::skip_any_simple_characters(scan);
+    if (!scan.remaining() || *(scan.position++) == '"') {
+      break;
+    }
+    scan.position += (scan.remaining() ? 1 : 0);  // skip the escaped character
+  }
+
+  const auto capacity = size_t(scan.position - begin_simple);
+  const auto data = static_cast<char *>(resource->allocate(capacity, 1));
+  const auto unescaped = decode_escaped_string(context, begin_simple, unescape_buffer{ data, 0 });
+  return std::string_view(data, unescaped.size);
 }
 
-void string_t::encode(encode_context &context, const object_type value) const {
+void encode_string(encode_context &context, const char *data, const size_t size) {
   context.append('"');
 
   // Write the strings in 1024 byte chunks, so that we do not have to reserve a
@@ -183,8 +251,8 @@ void string_t::encode(encode_context &context, const object_type value) const {
   // that is ok since write_escaped will not escape characters with the high bit
   // set, so the combined escaped string contains the correct UTF-8 characters
   // in the end.
-  auto chunk_begin = value.data();
-  const auto string_end = chunk_begin + value.size();
+  auto chunk_begin = data;
+  const auto string_end = chunk_begin + size;
 
   while (chunk_begin != string_end) {
     const auto chunk_end = std::min(chunk_begin + 1024, string_end);
@@ -195,6 +263,49 @@ void string_t::encode(encode_context &context, const object_type value) const {
   context.append('"');
 }
 
+}  // namespace
+
+string_t::object_type string_t::decode(decode_context &context) const {
+  detail::skip_1(context, '"');
+  return decode_string(context, std::string());
+}
+
+void string_t::decode_into(decode_context &context, object_type &value) const {
+  detail::skip_1(context, '"');
+  value = decode_string(context, std::move(value));
+}
+
+void string_t::encode(encode_context &context, const object_type value) const {
+  encode_string(context, value.data(), value.size());
+}
+
+pmr_string_t::object_type pmr_string_t::decode(decode_context &context) const {
+  detail::skip_1(context, '"');
+  if (const auto resource = context.memory_resource) {
+    return decode_string(context, std::pmr::string(resource));
+  } else {
+    return decode_string(context, std::pmr::string());
+  }
+}
+
+void pmr_string_t::decode_into(decode_context &context, object_type &value) const {
+  detail::skip_1(context, '"');
+  value = decode_string(context, std::move(value));
+}
+
+void pmr_string_t::encode(encode_context &context, const object_type &value) const {
+  encode_string(context, value.data(), value.size());
+}
+
+string_view_t::object_type string_view_t::decode(decode_context &context) const {
+  detail::skip_1(context, '"');
+  return decode_string_view(context);
+}
+
+void string_view_t::encode(encode_context &context, const object_type value) const {
+  encode_string(context, value.data(), value.size());
+}
+
 }  // namespace codec
 }  // namespace json
 }  // namespace spotify
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/cursor.hpp>
+
+#include <string>
+
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/json_pointer.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+
+namespace spotify {
+namespace json {
+
+cursor::cursor(const char *data, const size_t size)
+    : _begin(data),
+      _end(data + size),
+      _position(data),
+      _last_member(nullptr) {
+  auto context = this->context();
+  detail::skip_any_whitespace(context);
+  _position = context.position;
+}
+
+cursor::cursor(const encoded_value_ref &json)
+    : cursor(json.data(), json.size()) {}
+
+cursor::cursor(const cursor &parent, const char *position)
+    : _begin(parent._begin),
+      _end(parent._end),
+      _position(position),
+      _last_member(nullptr) {}
+
+decode_context cursor::context() const {
+  decode_context context(_begin, _end);
+  context.position = _position;
+  return context;
+}
+
+std::optional<cursor> cursor::find(const std::string_view key) const {
+  auto context = this->context();
+  detail::fail_if(context, detail::peek(context) != '{', "Expected '{'");
+
+  if (_last_member) {
+    context.position = _last_member;
+    if (detail::find_next_object_member(context, key)) {
+      _last_member = context.position;
+      return cursor(*this, context.position);
+    }
+    context.position = _position;
+  }
+
+  if (!detail::find_object_member(context, key)) {
+    return std::nullopt;
+  }
+  _last_member = context.position;
+  return cursor(*this, context.position);
+}
+
+cursor cursor::operator[](const std::string_view key) const {
+  if (const auto member = find(key)) {
+    return *member;
+  }
+  throw decode_exception(("Object has no member '" + std::string(key) + "'").c_str(), offset());
+}
+
+cursor cursor::operator[](const size_t index) const {
+  auto context = this->context();
+  detail::fail_if(context, detail::peek(context) != '[', "Expected '['");
+  if (!detail::find_array_element(context, index)) {
+    throw decode_exception("Array index out of range", offset());
+  }
+  return cursor(*this, context.position);
+}
+
+cursor cursor::at_pointer(const std::string_view pointer) const {
+  auto context = this->context();
+  detail::seek_json_pointer(context, detail::parse_json_pointer(pointer));
+  return cursor(*this, context.position);
+}
+
+bool cursor::is_null() const {
+  auto context = this->context();
+  if (detail::peek(context) != 'n') {
+    return false;
+  }
+  detail::skip_null(context);
+  return true;
+}
+
+encoded_value_ref cursor::json() const {
+  auto context = this->context();
+  detail::skip_value(context);
+  return encoded_value_ref(_position, context.position - _position, encoded_value_ref::unsafe_unchecked());
+}
+
+}  // namespace json
+}  // namespace spotify
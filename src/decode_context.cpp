@@ -20,13 +20,17 @@ namespace spotify {
 namespace json {
 
 decode_context::decode_context(const char *begin, const char *end)
-    : has_sse42(detail::cpuid().has_sse42()),
+    : kernels(&detail::default_kernel_table()),
+      structural_index(nullptr),
+      memory_resource(nullptr),
       position(begin),
       begin(begin),
       end(end) {}
 
 decode_context::decode_context(const char *data, size_t size)
-    : has_sse42(detail::cpuid().has_sse42()),
+    : kernels(&detail::default_kernel_table()),
+      structural_index(nullptr),
+      memory_resource(nullptr),
       position(data),
       begin(data),
       end(data + size) {}
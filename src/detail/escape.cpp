@@ -25,10 +25,6 @@ namespace spotify {
 namespace json {
 namespace detail {
 
-#if defined(json_arch_x86_sse42)
-void write_escaped_sse42(encode_context &context, const char *begin, const char *end);
-#endif  // defined(json_arch_x86_sse42)
-
 void write_escaped_scalar(encode_context &context, const char *begin, const char *end) {
   const auto buf = context.reserve(6 * (end - begin));  // 6 is the length of \u00xx
   auto ptr = buf;
@@ -44,15 +40,6 @@ void write_escaped_scalar(encode_context &context, const char *begin, const char
   context.advance(ptr - buf);
 }
 
-void write_escaped(encode_context &context, const char *begin, const char *end) {
-#if defined(json_arch_x86_sse42)
-  if (json_likely(context.has_sse42)) {
-    return write_escaped_sse42(context, begin, end);
-  }
-#endif  // defined(json_arch_x86_sse42)
-  write_escaped_scalar(context, begin, end);
-}
-
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
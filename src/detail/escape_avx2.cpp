@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/escape.hpp>
+
+#if defined(json_arch_x86_avx2)
+
+#include <immintrin.h>
+
+#include "escape_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+void write_escaped_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  const auto buf = context.reserve(6 * (end - begin));  // 6 is the length of \u00xx
+  auto out = buf;
+
+  const auto max_control_character = _mm256_set1_epi8(0x1F);
+  const auto quote = _mm256_set1_epi8('"');
+  const auto backslash = _mm256_set1_epi8('\\');
+
+  for (; end - begin >= 32; begin += 32) {
+    const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+    const auto is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, max_control_character), chunk);
+    const auto is_quote = _mm256_cmpeq_epi8(chunk, quote);
+    const auto is_backslash = _mm256_cmpeq_epi8(chunk, backslash);
+    const auto needs_escaping = _mm256_or_si256(is_control, _mm256_or_si256(is_quote, is_backslash));
+    if (json_likely(_mm256_testz_si256(needs_escaping, needs_escaping))) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chunk);
+      out += 32;
+    } else {
+      auto chunk_begin = begin;
+      write_escaped_8(out, chunk_begin);
+      write_escaped_8(out, chunk_begin);
+      write_escaped_8(out, chunk_begin);
+      write_escaped_8(out, chunk_begin);
+    }
+  }
+
+  while ((end - begin) >= 8) { write_escaped_8(out, begin); }
+  if    ((end - begin) >= 4) { write_escaped_4(out, begin); }
+  if    ((end - begin) >= 2) { write_escaped_2(out, begin); }
+  if    ((end - begin) >= 1) { write_escaped_1(out, begin); }
+
+  context.advance(out - buf);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx2)
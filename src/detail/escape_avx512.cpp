@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/escape.hpp>
+
+#if defined(json_arch_x86_avx512)
+
+#include <immintrin.h>
+
+#include "escape_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+void write_escaped_avx512(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  const auto buf = context.reserve(6 * (end - begin));  // 6 is the length of \u00xx
+  auto out = buf;
+
+  const auto max_control_character = _mm512_set1_epi8(0x1F);
+  const auto quote = _mm512_set1_epi8('"');
+  const auto backslash = _mm512_set1_epi8('\\');
+
+  for (; end - begin >= 64; begin += 64) {
+    const auto chunk = _mm512_loadu_si512(begin);
+    const auto needs_escaping =
+        _mm512_cmple_epu8_mask(chunk, max_control_character) |
+        _mm512_cmpeq_epi8_mask(chunk, quote) |
+        _mm512_cmpeq_epi8_mask(chunk, backslash);
+    if (json_likely(!needs_escaping)) {
+      _mm512_storeu_si512(out, chunk);
+      out += 64;
+    } else {
+      auto chunk_begin = begin;
+      for (int i = 0; i < 8; i++) {
+        write_escaped_8(out, chunk_begin);
+      }
+    }
+  }
+
+  while ((end - begin) >= 8) { write_escaped_8(out, begin); }
+  if    ((end - begin) >= 4) { write_escaped_4(out, begin); }
+  if    ((end - begin) >= 2) { write_escaped_2(out, begin); }
+  if    ((end - begin) >= 1) { write_escaped_1(out, begin); }
+
+  context.advance(out - buf);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx512)
@@ -16,6 +16,9 @@
 
 #include <spotify/json/detail/field_registry.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 #include <spotify/json/codec/string.hpp>
 #include <spotify/json/encode_context.hpp>
 
@@ -24,6 +27,21 @@ namespace json {
 namespace detail {
 namespace {
 
+/**
+ * Displacements are tried in order until all names of a bucket fit. With the
+ * hash table at most half full, buckets hardly ever need more than a handful
+ * of attempts, so failing to place a bucket means that there are names with
+ * colliding hashes, and a new seed is needed.
+ */
+const uint32_t max_displacement = 1 << 16;
+
+/**
+ * Seeds are tried in order until the hash table can be built. A second seed is
+ * rarely needed, so running out of seeds means that some names have the same
+ * 64-bit hash for every seed, and the names are binary searched instead.
+ */
+const uint64_t max_seeds = 64;
+
 std::string escape_key(const std::string &key) {
   encode_context context;
   codec::string().encode(context, key);
@@ -31,32 +49,282 @@ std::string escape_key(const std::string &key) {
   return std::string(context.data(), context.size());
 }
 
+json_force_inline uint64_t mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+json_force_inline uint64_t hash_key(const uint64_t seed, const char *data, size_t size) {
+  auto h = seed ^ (size * 0x9E3779B97F4A7C15ULL);
+  for (; size >= 8; data += 8, size -= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+    h = (h ^ word) * 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 32;
+  }
+
+  uint64_t tail = 0;
+  std::memcpy(&tail, data, size);
+  return mix(h ^ tail);
+}
+
+json_force_inline size_t bucket_of(const uint64_t hash, const size_t num_buckets) {
+  return size_t(((hash >> 32) * num_buckets) >> 32);
+}
+
 } // namespace
 
 field_registry::field_registry() = default;
 field_registry::~field_registry() = default;
-field_registry::field_registry(const field_registry &) = default;
-field_registry::field_registry(field_registry &&) = default;
+
+field_registry::field_registry(const field_registry &other) {
+  assign(other);
+}
+
+field_registry::field_registry(field_registry &&other) {
+  assign(std::move(other));
+}
+
+field_registry &field_registry::operator=(const field_registry &other) {
+  if (this != &other) {
+    assign(other);
+  }
+  return *this;
+}
+
+field_registry &field_registry::operator=(field_registry &&other) {
+  if (this != &other) {
+    assign(std::move(other));
+  }
+  return *this;
+}
+
+template <typename registry_type>
+void field_registry::assign(registry_type &&other) {
+  other.prepare();
+  _field_list = std::forward<registry_type>(other)._field_list;
+  _names = std::forward<registry_type>(other)._names;
+  _num_required_fields = other._num_required_fields;
+  _unbuilt_names.clear();
+  _built.store(true, std::memory_order_relaxed);
+  _build_once = std::make_unique<std::once_flag>();
+  _displacements = std::forward<registry_type>(other)._displacements;
+  _slots = std::forward<registry_type>(other)._slots;
+  _sorted = std::forward<registry_type>(other)._sorted;
+  _seed = other._seed;
+  _encode_literals = std::forward<registry_type>(other)._encode_literals;
+  _encode_size_hint = other._encode_size_hint;
+}
 
 void field_registry::save(const std::string &name, bool required,
                           const std::shared_ptr<field> &f) {
-  const auto was_saved =
-      _fields.insert(typename field_map::value_type(name, f)).second;
-  if (was_saved) {
-    _field_list.push_back(std::make_pair(escape_key(name), f));
-    _num_required_fields += required ? 1 : 0;
+  // The lookup table covers the names saved before it was last built, and
+  // _unbuilt_names the rest, so this does not need to build the table.
+  if (lookup(name.data(), name.size()) != json_size_t_max ||
+      !_unbuilt_names.insert(name).second) {
+    return;
+  }
+
+  _field_list.push_back(std::make_pair(escape_key(name), f));
+  _names.push_back(name);
+  _num_required_fields += required ? 1 : 0;
+  if (_built.load(std::memory_order_relaxed)) {
+    _build_once = std::make_unique<std::once_flag>();
+    _built.store(false, std::memory_order_release);
   }
 }
 
-const field *field_registry::find(const std::string &name) const noexcept {
-  const auto field_it = _fields.find(name);
-  if (json_likely(field_it != _fields.end())) {
-    return (*field_it).second.get();
+const field *field_registry::find(const char *name, const size_t size) const {
+  const auto index = find_index(name, size);
+  if (json_likely(index != json_size_t_max)) {
+    return _field_list[index].second.get();
   } else {
     return nullptr;
   }
 }
 
+const field *field_registry::find(const std::string &name) const {
+  return find(name.data(), name.size());
+}
+
+size_t field_registry::find_index(const char *name, const size_t size) const {
+  prepare();
+  return lookup(name, size);
+}
+
+size_t field_registry::find_index(const std::string &name) const {
+  return find_index(name.data(), name.size());
+}
+
+size_t field_registry::lookup(const char *name, const size_t size) const noexcept {
+  if (json_unlikely(_slots.empty())) {
+    // Either there are no fields, or no perfect hash table could be built.
+    const auto it = std::lower_bound(_sorted.begin(), _sorted.end(), size, [&](uint32_t i, size_t) {
+      const auto &candidate = _names[i];
+      return (candidate.size() != size ?
+          candidate.size() < size :
+          std::memcmp(candidate.data(), name, size) < 0);
+    });
+    if (it != _sorted.end() && _names[*it].size() == size && std::memcmp(_names[*it].data(), name, size) == 0) {
+      return *it;
+    } else {
+      return json_size_t_max;
+    }
+  }
+
+  const auto index = _slots[slot(hash_key(_seed, name, size))];
+  if (json_unlikely(!index)) {
+    return json_size_t_max;
+  }
+
+  const auto &candidate = _names[index - 1];
+  if (json_likely(candidate.size() == size && std::memcmp(candidate.data(), name, size) == 0)) {
+    return index - 1;
+  } else {
+    return json_size_t_max;
+  }
+}
+
+void field_registry::build() const {
+  std::call_once(*_build_once, [this] {
+    build_hash_table();
+    build_encode_plan();
+    std::unordered_set<std::string>().swap(_unbuilt_names);
+    _built.store(true, std::memory_order_release);
+  });
+}
+
+size_t field_registry::slot(const uint64_t hash) const noexcept {
+  const auto displacement = _displacements[bucket_of(hash, _displacements.size())];
+  return size_t(mix(hash ^ (displacement * 0x9E3779B97F4A7C15ULL)) & (_slots.size() - 1));
+}
+
+void field_registry::build_encode_plan() const {
+  _encode_literals.clear();
+  _encode_size_hint = 0;
+
+  for (const auto &kv : _field_list) {
+    if (!kv.second->is_always_encoded()) {
+      _encode_size_hint = 0;
+      return;
+    }
+  }
+
+  _encode_literals.emplace_back("{");
+  for (const auto &kv : _field_list) {
+    _encode_literals.back() += kv.first;
+    _encode_literals.emplace_back(",");
+    _encode_size_hint += kv.second->max_encoded_size();
+  }
+
+  // The last literal is the ',' after the last field, or '{' if there are no
+  // fields at all.
+  auto &last = _encode_literals.back();
+  if (last == ",") {
+    last = "}";
+  } else {
+    last += "}";
+  }
+
+  for (const auto &literal : _encode_literals) {
+    _encode_size_hint += literal.size();
+  }
+}
+
+void field_registry::build_hash_table() const {
+  _sorted.clear();
+  for (uint64_t seed = 0; seed < max_seeds; seed++) {
+    if (try_build_hash_table(seed)) {
+      return;
+    }
+  }
+
+  _displacements.clear();
+  _slots.clear();
+  build_sorted_names();
+}
+
+void field_registry::build_sorted_names() const {
+  _sorted.resize(_names.size());
+  for (size_t i = 0; i < _names.size(); i++) {
+    _sorted[i] = uint32_t(i);
+  }
+  std::sort(_sorted.begin(), _sorted.end(), [&](uint32_t a, uint32_t b) {
+    const auto &name_a = _names[a];
+    const auto &name_b = _names[b];
+    return (name_a.size() != name_b.size() ?
+        name_a.size() < name_b.size() :
+        std::memcmp(name_a.data(), name_b.data(), name_a.size()) < 0);
+  });
+}
+
+bool field_registry::try_build_hash_table(const uint64_t seed) const {
+  const auto num_names = _names.size();
+  const auto num_buckets = (num_names + 1) / 2;
+  auto num_slots = size_t(1);
+  while (num_slots < 2 * num_names) {
+    num_slots <<= 1;
+  }
+
+  _seed = seed;
+  _displacements.assign(num_buckets, 0);
+  _slots.assign(num_slots, 0);
+
+  std::vector<uint64_t> hashes(num_names);
+  std::vector<std::vector<uint32_t>> buckets(num_buckets);
+  for (size_t i = 0; i < num_names; i++) {
+    hashes[i] = hash_key(seed, _names[i].data(), _names[i].size());
+    buckets[bucket_of(hashes[i], num_buckets)].push_back(uint32_t(i));
+  }
+
+  // Place the largest buckets first, while the table is still mostly empty.
+  std::vector<size_t> order(num_buckets);
+  for (size_t b = 0; b < num_buckets; b++) {
+    order[b] = b;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  std::vector<size_t> candidate_slots;
+  for (const auto b : order) {
+    const auto &bucket = buckets[b];
+    if (bucket.empty()) {
+      break;
+    }
+
+    auto placed = false;
+    for (uint32_t displacement = 0; !placed && displacement < max_displacement; displacement++) {
+      _displacements[b] = displacement;
+      candidate_slots.clear();
+      placed = true;
+      for (const auto i : bucket) {
+        const auto s = slot(hashes[i]);
+        const auto taken = std::find(candidate_slots.begin(), candidate_slots.end(), s);
+        if (_slots[s] || taken != candidate_slots.end()) {
+          placed = false;
+          break;
+        }
+        candidate_slots.push_back(s);
+      }
+    }
+
+    if (!placed) {
+      return false;
+    }
+
+    for (size_t k = 0; k < bucket.size(); k++) {
+      _slots[candidate_slots[k]] = bucket[k] + 1;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
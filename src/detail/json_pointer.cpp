@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/detail/json_pointer.hpp>
+
+#include <stdexcept>
+
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+/**
+ * Advance context.position from the value of a member to the key of the next
+ * member. Returns false, with context.position after the '}', if there is no
+ * next member.
+ */
+bool skip_to_next_member(decode_context &context) {
+  skip_value(context);
+  skip_any_whitespace(context);
+  const auto c = next(context, "Expected '}'");
+  if (c == '}') {
+    return false;
+  }
+  fail_if(context, c != ',', "Expected ',' or '}'", -1);
+  skip_any_whitespace(context);
+  return true;
+}
+
+bool find_member_from_key(decode_context &context, const std::string_view key) {
+  std::string scratch;
+  while (true) {
+    const auto found = (read_key(context, scratch) == key);
+    skip_any_whitespace(context);
+    skip_1(context, ':');
+    skip_any_whitespace(context);
+    if (found) {
+      return true;
+    }
+    if (!skip_to_next_member(context)) {
+      return false;
+    }
+  }
+}
+
+}  // namespace
+
+size_t parse_array_index(const std::string_view token) {
+  if (token.empty() || (token[0] == '0' && token.size() > 1)) {
+    return json_size_t_max;
+  }
+
+  size_t index = 0;
+  for (const auto c : token) {
+    if (c < '0' || c > '9' || index > (json_size_t_max - 9) / 10) {
+      return json_size_t_max;
+    }
+    index = index * 10 + size_t(c - '0');
+  }
+  return index;
+}
+
+std::string_view read_key(decode_context &context, std::string &scratch) {
+  const auto begin = context.position;
+  skip_string(context);
+
+  const auto raw = std::string_view(begin + 1, context.position - begin - 2);
+  if (json_likely(raw.find('\\') == std::string_view::npos)) {
+    return raw;
+  }
+
+  context.position = begin;
+  scratch = codec::string().decode(context);
+  return scratch;
+}
+
+bool find_object_member(decode_context &context, const std::string_view key) {
+  skip_1(context, '{');
+  skip_any_whitespace(context);
+  if (peek(context) == '}') {
+    skip_unchecked_1(context);
+    return false;
+  }
+  return find_member_from_key(context, key);
+}
+
+bool find_next_object_member(decode_context &context, const std::string_view key) {
+  return skip_to_next_member(context) && find_member_from_key(context, key);
+}
+
+bool find_array_element(decode_context &context, const size_t index) {
+  skip_1(context, '[');
+  skip_any_whitespace(context);
+  if (peek(context) == ']') {
+    skip_unchecked_1(context);
+    return false;
+  }
+
+  for (size_t i = 0; i < index; i++) {
+    skip_value(context);
+    skip_any_whitespace(context);
+    const auto c = next(context, "Expected ']'");
+    if (c == ']') {
+      return false;
+    }
+    fail_if(context, c != ',', "Expected ',' or ']'", -1);
+    skip_any_whitespace(context);
+  }
+  return true;
+}
+
+std::vector<std::string> parse_json_pointer(const std::string_view pointer) {
+  std::vector<std::string> tokens;
+  if (pointer.empty()) {
+    return tokens;
+  }
+  if (pointer[0] != '/') {
+    throw std::invalid_argument("JSON Pointer must be empty or start with '/'");
+  }
+
+  for (size_t i = 1; i <= pointer.size(); i++) {
+    std::string token;
+    for (; i < pointer.size() && pointer[i] != '/'; i++) {
+      if (pointer[i] != '~') {
+        token += pointer[i];
+      } else if (i + 1 < pointer.size() && (pointer[i + 1] == '0' || pointer[i + 1] == '1')) {
+        token += (pointer[++i] == '0' ? '~' : '/');
+      } else {
+        throw std::invalid_argument("Invalid escape in JSON Pointer");
+      }
+    }
+    tokens.push_back(std::move(token));
+  }
+  return tokens;
+}
+
+void seek_json_pointer(decode_context &context, const std::vector<std::string> &tokens) {
+  for (const auto &token : tokens) {
+    skip_any_whitespace(context);
+    switch (peek(context)) {
+      case '{':
+        fail_if(context, !find_object_member(context, token), "JSON Pointer not found", -1);
+        break;
+      case '[': {
+        const auto index = parse_array_index(token);
+        fail_if(context, index == json_size_t_max, "JSON Pointer token is not an array index");
+        fail_if(context, !find_array_element(context, index), "JSON Pointer not found", -1);
+        break;
+      }
+      default:
+        fail(context, "JSON Pointer not found");
+    }
+  }
+  skip_any_whitespace(context);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
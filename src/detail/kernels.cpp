@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/kernels.hpp>
+
+#include <algorithm>
+
+#include <spotify/json/detail/cpuid.hpp>
+#include <spotify/json/detail/escape.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/structural_index.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+const kernel_table scalar_kernels = {
+  kernel_tier::scalar,
+  &skip_any_simple_characters_scalar,
+  &skip_any_whitespace_scalar,
+  &write_escaped_scalar,
+  &index_structurals_scalar
+};
+
+#if defined(json_arch_x86_sse42)
+const kernel_table sse42_kernels = {
+  kernel_tier::sse42,
+  &skip_any_simple_characters_sse42,
+  &skip_any_whitespace_sse42,
+  &write_escaped_sse42,
+  &index_structurals_sse42
+};
+#endif  // defined(json_arch_x86_sse42)
+
+#if defined(json_arch_x86_avx2)
+const kernel_table avx2_kernels = {
+  kernel_tier::avx2,
+  &skip_any_simple_characters_avx2,
+  &skip_any_whitespace_avx2,
+  &write_escaped_avx2,
+  &index_structurals_avx2
+};
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512)
+const kernel_table avx512_kernels = {
+  kernel_tier::avx512,
+  &skip_any_simple_characters_avx512,
+  &skip_any_whitespace_avx512,
+  &write_escaped_avx512,
+  &index_structurals_avx512
+};
+#endif  // defined(json_arch_x86_avx512)
+
+kernel_tier detect_supported_tier() {
+  const cpuid cpu;
+  if (cpu.has_avx512bw() && cpu.has_pclmulqdq()) { return kernel_tier::avx512; }
+  if (cpu.has_avx2() && cpu.has_pclmulqdq()) { return kernel_tier::avx2; }
+  if (cpu.has_sse42()) { return kernel_tier::sse42; }
+  return kernel_tier::scalar;
+}
+
+kernel_tier supported_tier() {
+  static const auto tier = detect_supported_tier();
+  return tier;
+}
+
+}  // namespace
+
+const kernel_table &default_kernel_table() {
+  static const auto &table = kernel_table_for(kernel_tier::avx512);
+  return table;
+}
+
+const kernel_table &kernel_table_for(const kernel_tier tier) {
+  const auto usable_tier = std::min(tier, supported_tier());
+#if defined(json_arch_x86_avx512)
+  if (usable_tier >= kernel_tier::avx512) { return avx512_kernels; }
+#endif  // defined(json_arch_x86_avx512)
+#if defined(json_arch_x86_avx2)
+  if (usable_tier >= kernel_tier::avx2) { return avx2_kernels; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (usable_tier >= kernel_tier::sse42) { return sse42_kernels; }
+#endif  // defined(json_arch_x86_sse42)
+  return scalar_kernels;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/detail/parallel_for.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+std::size_t resolve_num_threads(const std::size_t num_threads) {
+  return (num_threads ? num_threads : std::max(1u, std::thread::hardware_concurrency()));
+}
+
+void parallel_for(
+    const std::size_t num_tasks,
+    std::size_t num_threads,
+    const std::function<void (std::size_t)> &task) {
+  num_threads = std::min(resolve_num_threads(num_threads), num_tasks);
+
+  std::atomic<std::size_t> next_task(0);
+  std::atomic<bool> failed(false);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto error_task = json_size_t_max;
+
+  const auto worker = [&]{
+    while (json_likely(!failed.load(std::memory_order_relaxed))) {
+      const auto i = next_task.fetch_add(1, std::memory_order_relaxed);
+      if (i >= num_tasks) {
+        break;
+      }
+
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (i < error_task) {
+          error_task = i;
+          error = std::current_exception();
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads ? num_threads - 1 : 0);
+  for (std::size_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The powers of five from 5^smallest_power_of_five to 5^largest_power_of_five,
+ * as 128 bit values with the most significant bit set: two uint64_t per power,
+ * the high half first. Powers that do not fit in 128 bits are truncated, and
+ * negative powers are rounded up. This is the table of the Eisel-Lemire
+ * algorithm, used to decode floating point numbers in number.cpp.
+ */
+constexpr int smallest_power_of_five = -342;
+constexpr int largest_power_of_five = 308;
+extern const uint64_t power_of_five_128[2 * (largest_power_of_five - smallest_power_of_five + 1)];
+
+/**
+ * The powers of five 5^0 to 5^325 truncated to 125 bits, and the inverses
+ * 2^(k - 1 + 125) / 5^q for q from 0 to 341 rounded up, where k is the bit
+ * length of 5^q. Two uint64_t per power, the high half first. These are the
+ * tables of the Ryu algorithm, used to encode floating point numbers in
+ * number.cpp.
+ */
+constexpr int power_of_five_125_size = 326;
+constexpr int inverse_power_of_five_125_size = 342;
+extern const uint64_t power_of_five_125[2 * power_of_five_125_size];
+extern const uint64_t inverse_power_of_five_125[2 * inverse_power_of_five_125_size];
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
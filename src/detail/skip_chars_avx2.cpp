@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/skip_chars.hpp>
+
+#if defined(json_arch_x86_avx2)
+
+#include <immintrin.h>
+
+#include "skip_chars_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline unsigned count_trailing_zeros(const uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif  // defined(_MSC_VER)
+}
+
+}  // namespace
+
+void skip_any_simple_characters_avx2(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  const auto quote = _mm256_set1_epi8('"');
+  const auto backslash = _mm256_set1_epi8('\\');
+
+  for (; end - pos >= 32; pos += 32) {
+    const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+    const auto is_quote = _mm256_cmpeq_epi8(chunk, quote);
+    const auto is_backslash = _mm256_cmpeq_epi8(chunk, backslash);
+    const auto mask = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(is_quote, is_backslash)));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(mask);
+      return;
+    }
+  }
+
+          JSON_STRING_SKIP_N_SIMPLE(8, x, uint64_t, while, done_8)
+  done_8: JSON_STRING_SKIP_N_SIMPLE(4, x, uint32_t, while, done_4)
+  done_4: JSON_STRING_SKIP_N_SIMPLE(2, x, uint16_t, while, done_2)
+  done_2: JSON_STRING_SKIP_N_SIMPLE(1, x, uint8_t,  while, done_x)
+  done_x: context.position = pos;
+}
+
+void skip_any_whitespace_avx2(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  // Whitespace characters are looked up by their low nibble, which is unique
+  // for each of them. Bytes with the high bit set are shuffled to zero and can
+  // never match, and all unused table entries are 0xFF for the same reason.
+  const auto whitespace = _mm256_setr_epi8(
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1);
+
+  for (; end - pos >= 32; pos += 32) {
+    const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+    const auto spaces = _mm256_cmpeq_epi8(_mm256_shuffle_epi8(whitespace, chunk), chunk);
+    const auto mask = ~uint32_t(_mm256_movemask_epi8(spaces));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(mask);
+      return;
+    }
+  }
+
+  while (pos < end && is_space(*pos)) {
+    ++pos;
+  }
+
+  context.position = pos;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx2)
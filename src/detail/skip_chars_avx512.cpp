@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/skip_chars.hpp>
+
+#if defined(json_arch_x86_avx512)
+
+#include <immintrin.h>
+
+#include "skip_chars_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline unsigned count_trailing_zeros(const uint64_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return index;
+#else
+  return __builtin_ctzll(mask);
+#endif  // defined(_MSC_VER)
+}
+
+/**
+ * Load the bytes in [pos, end), at most 64 of them, into a vector. Bytes past
+ * the end are zeroed. The masked load never touches memory outside of the
+ * range, so this is safe to use at the end of the input buffer.
+ */
+json_force_inline __m512i load_tail(const char *pos, const char *end, __mmask64 &valid) {
+  const auto size = static_cast<unsigned>(end - pos);
+  valid = (size >= 64 ? ~__mmask64(0) : ((__mmask64(1) << size) - 1));
+  return _mm512_maskz_loadu_epi8(valid, pos);
+}
+
+}  // namespace
+
+void skip_any_simple_characters_avx512(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  const auto quote = _mm512_set1_epi8('"');
+  const auto backslash = _mm512_set1_epi8('\\');
+
+  for (; end - pos >= 64; pos += 64) {
+    const auto chunk = _mm512_loadu_si512(pos);
+    const auto mask = uint64_t(
+        _mm512_cmpeq_epi8_mask(chunk, quote) |
+        _mm512_cmpeq_epi8_mask(chunk, backslash));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(mask);
+      return;
+    }
+  }
+
+  if (pos < end) {
+    // Zeroed bytes past the end never compare equal to '"' or '\'.
+    __mmask64 valid;
+    const auto chunk = load_tail(pos, end, valid);
+    const auto mask = uint64_t(
+        _mm512_cmpeq_epi8_mask(chunk, quote) |
+        _mm512_cmpeq_epi8_mask(chunk, backslash));
+    pos = (mask ? pos + count_trailing_zeros(mask) : end);
+  }
+
+  context.position = pos;
+}
+
+void skip_any_whitespace_avx512(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  // See skip_any_whitespace_avx2 for how this lookup table works. The shuffle
+  // operates on each 128 bit lane separately, so the table is repeated.
+  const auto whitespace = _mm512_broadcast_i32x4(_mm_setr_epi8(
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1));
+
+  for (; end - pos >= 64; pos += 64) {
+    const auto chunk = _mm512_loadu_si512(pos);
+    const auto spaces = _mm512_cmpeq_epi8_mask(_mm512_shuffle_epi8(whitespace, chunk), chunk);
+    const auto mask = ~uint64_t(spaces);
+    if (mask) {
+      context.position = pos + count_trailing_zeros(mask);
+      return;
+    }
+  }
+
+  if (pos < end) {
+    // Zeroed bytes past the end are not whitespace, so they must be masked out.
+    __mmask64 valid;
+    const auto chunk = load_tail(pos, end, valid);
+    const auto spaces = _mm512_cmpeq_epi8_mask(_mm512_shuffle_epi8(whitespace, chunk), chunk);
+    const auto mask = ~uint64_t(spaces) & uint64_t(valid);
+    pos = (mask ? pos + count_trailing_zeros(mask) : end);
+  }
+
+  context.position = pos;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx512)
@@ -21,6 +21,7 @@
 #include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/detail/stack.hpp>
+#include <spotify/json/detail/structural_index.hpp>
 
 namespace spotify {
 namespace json {
@@ -59,6 +60,8 @@ void skip_escape(decode_context &context) {
   }
 }
 
+}  // namespace
+
 void skip_string(decode_context &context) {
   skip_1(context, '"');
 
@@ -109,6 +112,8 @@ void skip_number(decode_context &context) {
   }
 }
 
+namespace {
+
 /**
  * Advance past one simple JSON value, that is any value that is not an object
  * {} or an array []. If parsing fails, context will be set to that it has
@@ -130,9 +135,34 @@ void skip_simple_value(decode_context &context) {
   }
 }
 
+/**
+ * Advance past the array or object at context.position by looking up its
+ * closing bracket in the structural index of the context. Only the balance of
+ * the brackets is verified, not the values inside of the array or object.
+ */
+void skip_indexed_container(decode_context &context, const structural_index &index) {
+  const auto opener = peek_unchecked(context);
+  const auto closer = char(opener + 2);  // '{' + 2 == '}', '[' + 2 == ']'
+  const auto error = (opener == '{' ? "Expected '}'" : "Expected ']'");
+  const auto close = index.find_matching_close(context.position);
+  fail_if(context, !close || close >= context.end, error);
+  context.position = close;
+  fail_if(context, *close != closer, error);
+  context.position = close + 1;
+}
+
 }  // namespace
 
 void skip_value(decode_context &context) {
+  const auto index = context.structural_index;
+  if (index && context.remaining() &&
+      context.position >= index->begin() && context.position < index->end()) {
+    const auto c = peek_unchecked(context);
+    if (c == '{' || c == '[') {
+      return skip_indexed_container(context, *index);
+    }
+  }
+
   enum state {
     done = 0,
     want = 1 << 0,
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/detail/split_records.hpp>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/detail/structural_index.hpp>
+#include <spotify/json/detail/value_scanner.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+namespace {
+
+/**
+ * Find the end of the string, number or literal at value_begin. Errors are
+ * reported with offsets from the beginning of the buffer.
+ */
+const char *scan_value(
+    value_scanner &scanner,
+    const char *value_begin,
+    const char *end,
+    const size_t offset) {
+  try {
+    scanner.reset();
+    const auto value_end = scanner.scan(value_begin, end);
+    if (value_end) {
+      return value_end;
+    }
+    scanner.finish();  // throws if the value is not terminated
+    return end;
+  } catch (decode_exception &exception) {
+    const auto exception_offset = offset + exception.offset();
+    throw decode_exception(std::move(exception), exception_offset);
+  }
+}
+
+}  // namespace
+
+std::vector<record> split_records(const char *begin, const char *end, const kernel_table &kernels) {
+  const structural_index index(begin, end, kernels);
+  decode_context context(begin, end);
+  context.kernels = &kernels;
+
+  std::vector<record> records;
+  value_scanner scanner(kernels);
+  while (true) {
+    skip_any_whitespace(context);
+    if (context.position == context.end) {
+      return records;
+    }
+
+    const auto record_begin = context.position;
+    const auto c = *record_begin;
+    if (c == '{' || c == '[') {
+      const auto close = index.find_matching_close(record_begin);
+      fail_if(context, !close, c == '{' ? "Expected '}'" : "Expected ']'", end - record_begin);
+      context.position = close + 1;
+    } else {
+      context.position = scan_value(scanner, record_begin, end, size_t(record_begin - begin));
+    }
+
+    records.push_back(record{ record_begin, context.position });
+  }
+}
+
+std::vector<record> split_array(decode_context &context, const size_t slice_size) {
+  skip_1(context, '[');
+  skip_any_whitespace(context);
+
+  std::vector<record> slices;
+  if (peek(context) == ']') {
+    context.position++;
+    return slices;
+  }
+
+  auto slice_begin = context.position;
+  while (true) {
+    skip_value(context);
+    skip_any_whitespace(context);
+
+    const auto separator = context.position;
+    if (peek(context) == ']') {
+      slices.push_back(record{ slice_begin, separator });
+      context.position++;
+      return slices;
+    }
+
+    skip_1(context, ',');
+    skip_any_whitespace(context);
+    if (size_t(context.position - slice_begin) >= slice_size) {
+      slices.push_back(record{ slice_begin, separator });
+      slice_begin = context.position;
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
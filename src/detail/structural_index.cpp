@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/structural_index.hpp>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif  // defined(_MSC_VER)
+
+#include "structural_index_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline unsigned count_trailing_zeros(const uint64_t mask) {
+#if defined(_MSC_VER) && defined(json_arch_x86_64)
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return index;
+#elif defined(_MSC_VER)
+  unsigned long index;
+  if (_BitScanForward(&index, uint32_t(mask))) {
+    return index;
+  }
+  _BitScanForward(&index, uint32_t(mask >> 32));
+  return index + 32;
+#else
+  return __builtin_ctzll(mask);
+#endif  // defined(_MSC_VER)
+}
+
+json_force_inline int count_bits(uint64_t mask) {
+#if defined(_MSC_VER)
+  mask = mask - ((mask >> 1) & 0x5555555555555555ULL);
+  mask = (mask & 0x3333333333333333ULL) + ((mask >> 2) & 0x3333333333333333ULL);
+  mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return int((mask * 0x0101010101010101ULL) >> 56);
+#else
+  return __builtin_popcountll(mask);
+#endif  // defined(_MSC_VER)
+}
+
+json_force_inline structural_masks classify_scalar(const char *block) {
+  structural_masks masks = { 0, 0, 0, 0 };
+  for (unsigned i = 0; i < 64; i++) {
+    const auto bit = uint64_t(1) << i;
+    switch (block[i]) {
+      case '\\': masks.backslash |= bit; break;
+      case '"': masks.quote |= bit; break;
+      case '{': case '[': masks.open |= bit; break;
+      case '}': case ']': masks.close |= bit; break;
+      default: break;
+    }
+  }
+  return masks;
+}
+
+void build(
+    const kernel_table &kernels,
+    const char *begin,
+    const char *end,
+    uint64_t *opens,
+    uint64_t *closes) {
+  structural_state state;
+#if defined(json_fixed_kernel)
+  (void)kernels;
+  json_fixed_kernel(index_structurals)(state, begin, end, opens, closes);
+#else
+  kernels.index_structurals(state, begin, end, opens, closes);
+#endif  // defined(json_fixed_kernel)
+}
+
+}  // namespace
+
+void index_structurals_scalar(
+    structural_state &state,
+    const char *begin,
+    const char *end,
+    uint64_t *opens,
+    uint64_t *closes) {
+  index_structurals(state, begin, end, opens, closes, classify_scalar, prefix_xor_shift);
+}
+
+structural_index::structural_index(const char *begin, const char *end)
+    : structural_index(begin, end, default_kernel_table()) {}
+
+structural_index::structural_index(
+    const char *begin,
+    const char *end,
+    const kernel_table &kernels)
+    : _begin(begin),
+      _end(end),
+      _opens((end - begin + 63) / 64),
+      _closes((end - begin + 63) / 64) {
+  build(kernels, begin, end, _opens.data(), _closes.data());
+}
+
+const char *structural_index::find_matching_close(const char *open) const {
+  const auto offset = std::size_t(open - _begin);
+  auto block = offset / 64;
+  const auto after_open = (~uint64_t(0) << (offset % 64)) << 1;
+  auto opens = _opens[block] & after_open;
+  auto closes = _closes[block] & after_open;
+  auto depth = 1;
+
+  for (;;) {
+    // The depth can only drop to zero within this block if it has at least as
+    // many closing brackets as the current depth.
+    const auto num_closes = count_bits(closes);
+    if (json_likely(num_closes < depth)) {
+      depth += count_bits(opens) - num_closes;
+    } else {
+      for (auto brackets = opens | closes; brackets; brackets &= brackets - 1) {
+        const auto bit = brackets & (~brackets + 1);
+        if (!(closes & bit)) {
+          depth++;
+        } else if (--depth == 0) {
+          return _begin + block * 64 + count_trailing_zeros(bit);
+        }
+      }
+    }
+
+    if (++block == _opens.size()) {
+      return nullptr;
+    }
+
+    opens = _opens[block];
+    closes = _closes[block];
+  }
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <spotify/json/detail/structural_index.hpp>
+
+#if defined(json_arch_x86_avx2)
+
+#include <immintrin.h>
+#include <wmmintrin.h>
+
+#include "structural_index_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline uint64_t movemask_32(const __m256i mask) {
+  return uint64_t(uint32_t(_mm256_movemask_epi8(mask)));
+}
+
+json_force_inline uint64_t movemask_64(const __m256i lo, const __m256i hi) {
+  return movemask_32(lo) | (movemask_32(hi) << 32);
+}
+
+json_force_inline structural_masks classify_avx2(const char *block) {
+  const auto backslash = _mm256_set1_epi8('\\');
+  const auto quote = _mm256_set1_epi8('"');
+  const auto open = _mm256_set1_epi8('{');
+  const auto close = _mm256_set1_epi8('}');
+  const auto lower_case = _mm256_set1_epi8(0x20);  // '[' | 0x20 == '{', ']' | 0x20 == '}'
+
+  const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+  const auto folded_lo = _mm256_or_si256(lo, lower_case);
+  const auto folded_hi = _mm256_or_si256(hi, lower_case);
+
+  structural_masks masks;
+  masks.backslash = movemask_64(_mm256_cmpeq_epi8(lo, backslash), _mm256_cmpeq_epi8(hi, backslash));
+  masks.quote = movemask_64(_mm256_cmpeq_epi8(lo, quote), _mm256_cmpeq_epi8(hi, quote));
+  masks.open = movemask_64(_mm256_cmpeq_epi8(folded_lo, open), _mm256_cmpeq_epi8(folded_hi, open));
+  masks.close = movemask_64(_mm256_cmpeq_epi8(folded_lo, close), _mm256_cmpeq_epi8(folded_hi, close));
+  return masks;
+}
+
+/**
+ * A carry-less multiplication by all ones computes the prefix xor in a single
+ * instruction.
+ */
+json_force_inline uint64_t prefix_xor_clmul(const uint64_t bits) {
+  const auto product = _mm_clmulepi64_si128(
+      _mm_set_epi64x(0, int64_t(bits)),
+      _mm_set1_epi8(char(0xFF)),
+      0);
+  uint64_t result;
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(&result), product);
+  return result;
+}
+
+}  // namespace
+
+void index_structurals_avx2(
+    structural_state &state,
+    const char *begin,
+    const char *end,
+    uint64_t *opens,
+    uint64_t *closes) {
+  index_structurals(state, begin, end, opens, closes, classify_avx2, prefix_xor_clmul);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx2)
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <spotify/json/detail/structural_index.hpp>
+
+#if defined(json_arch_x86_avx512)
+
+#include <immintrin.h>
+#include <wmmintrin.h>
+
+#include "structural_index_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline structural_masks classify_avx512(const char *block) {
+  const auto backslash = _mm512_set1_epi8('\\');
+  const auto quote = _mm512_set1_epi8('"');
+  const auto open = _mm512_set1_epi8('{');
+  const auto close = _mm512_set1_epi8('}');
+  const auto lower_case = _mm512_set1_epi8(0x20);  // '[' | 0x20 == '{', ']' | 0x20 == '}'
+
+  const auto chunk = _mm512_loadu_si512(block);
+  const auto folded = _mm512_or_si512(chunk, lower_case);
+
+  structural_masks masks;
+  masks.backslash = _mm512_cmpeq_epi8_mask(chunk, backslash);
+  masks.quote = _mm512_cmpeq_epi8_mask(chunk, quote);
+  masks.open = _mm512_cmpeq_epi8_mask(folded, open);
+  masks.close = _mm512_cmpeq_epi8_mask(folded, close);
+  return masks;
+}
+
+/**
+ * A carry-less multiplication by all ones computes the prefix xor in a single
+ * instruction.
+ */
+json_force_inline uint64_t prefix_xor_clmul(const uint64_t bits) {
+  const auto product = _mm_clmulepi64_si128(
+      _mm_set_epi64x(0, int64_t(bits)),
+      _mm_set1_epi8(char(0xFF)),
+      0);
+  uint64_t result;
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(&result), product);
+  return result;
+}
+
+}  // namespace
+
+void index_structurals_avx512(
+    structural_state &state,
+    const char *begin,
+    const char *end,
+    uint64_t *opens,
+    uint64_t *closes) {
+  index_structurals(state, begin, end, opens, closes, classify_avx512, prefix_xor_clmul);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx512)
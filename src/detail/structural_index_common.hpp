@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/structural_index.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The characters of one 64 byte block that the structural index cares about.
+ * Bit i of each mask corresponds to character i of the block.
+ */
+struct structural_masks {
+  uint64_t backslash;
+  uint64_t quote;
+  uint64_t open;   // '{' or '['
+  uint64_t close;  // '}' or ']'
+};
+
+/**
+ * Bit i of the result is the exclusive or of bits 0 to i of the input. This
+ * turns a mask of unescaped quotes into a mask of the characters that are
+ * inside of strings (including the opening but not the closing quote).
+ */
+json_force_inline uint64_t prefix_xor_shift(uint64_t bits) {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+/**
+ * Mask out the quotes that are escaped by an odd number of backslashes. This
+ * is the branchless technique from "Parsing Gigabytes of JSON per Second"
+ * (Langdale & Lemire): runs of backslashes are found with a carrying addition,
+ * and runs of odd length that start on an even (odd) bit end on an odd (even)
+ * bit.
+ */
+json_force_inline uint64_t find_escaped_characters(structural_state &state, const uint64_t backslash) {
+  const uint64_t even_bits = 0x5555555555555555ULL;
+  const uint64_t odd_bits = ~even_bits;
+
+  const uint64_t start_edges = backslash & ~(backslash << 1);
+  const uint64_t even_start_mask = even_bits ^ state.ends_odd_backslash;
+  const uint64_t even_starts = start_edges & even_start_mask;
+  const uint64_t odd_starts = start_edges & ~even_start_mask;
+  const uint64_t even_carries = backslash + even_starts;
+  uint64_t odd_carries = backslash + odd_starts;
+  const bool ends_odd_backslash = (odd_carries < backslash);
+  odd_carries |= state.ends_odd_backslash;
+  state.ends_odd_backslash = ends_odd_backslash ? 1 : 0;
+
+  const uint64_t even_carry_ends = even_carries & ~backslash;
+  const uint64_t odd_carry_ends = odd_carries & ~backslash;
+  const uint64_t even_start_odd_end = even_carry_ends & odd_bits;
+  const uint64_t odd_start_even_end = odd_carry_ends & even_bits;
+  return even_start_odd_end | odd_start_even_end;
+}
+
+/**
+ * Build the structural index for [begin, end), with classify computing the
+ * masks of one 64 byte block and prefix_xor computing the in-string mask from
+ * the unescaped quotes. The last partial block is padded with spaces.
+ */
+template <typename classify_function, typename prefix_xor_function>
+json_force_inline void index_structurals(
+    structural_state &state,
+    const char *begin,
+    const char *end,
+    uint64_t *opens,
+    uint64_t *closes,
+    classify_function classify,
+    prefix_xor_function prefix_xor) {
+  const auto index_block = [&](const char *block) {
+    const auto masks = classify(block);
+    const auto quotes = masks.quote & ~find_escaped_characters(state, masks.backslash);
+    const auto inside_string = prefix_xor(quotes) ^ state.inside_string;
+    state.inside_string = uint64_t(int64_t(inside_string) >> 63);
+    *(opens++) = masks.open & ~inside_string;
+    *(closes++) = masks.close & ~inside_string;
+  };
+
+  for (; end - begin >= 64; begin += 64) {
+    index_block(begin);
+  }
+
+  if (begin != end) {
+    char block[64];
+    std::memset(block, ' ', sizeof(block));
+    std::memcpy(block, begin, end - begin);
+    index_block(block);
+  }
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <spotify/json/detail/structural_index.hpp>
+
+#if defined(json_arch_x86_sse42)
+
+#include <nmmintrin.h>
+
+#include "structural_index_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline uint64_t movemask_16(const __m128i mask) {
+  return uint64_t(uint16_t(_mm_movemask_epi8(mask)));
+}
+
+json_force_inline structural_masks classify_sse42(const char *block) {
+  const auto backslash = _mm_set1_epi8('\\');
+  const auto quote = _mm_set1_epi8('"');
+  const auto open = _mm_set1_epi8('{');
+  const auto close = _mm_set1_epi8('}');
+  const auto lower_case = _mm_set1_epi8(0x20);  // '[' | 0x20 == '{', ']' | 0x20 == '}'
+
+  structural_masks masks = { 0, 0, 0, 0 };
+  for (unsigned i = 0; i < 64; i += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+    const auto folded = _mm_or_si128(chunk, lower_case);
+    masks.backslash |= movemask_16(_mm_cmpeq_epi8(chunk, backslash)) << i;
+    masks.quote |= movemask_16(_mm_cmpeq_epi8(chunk, quote)) << i;
+    masks.open |= movemask_16(_mm_cmpeq_epi8(folded, open)) << i;
+    masks.close |= movemask_16(_mm_cmpeq_epi8(folded, close)) << i;
+  }
+  return masks;
+}
+
+}  // namespace
+
+void index_structurals_sse42(
+    structural_state &state,
+    const char *begin,
+    const char *end,
+    uint64_t *opens,
+    uint64_t *closes) {
+  index_structurals(state, begin, end, opens, closes, classify_sse42, prefix_xor_shift);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_sse42)
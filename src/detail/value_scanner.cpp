@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/detail/value_scanner.hpp>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline bool is_whitespace(const char c) {
+  return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+}
+
+json_force_inline bool ends_scalar(const char c) {
+  switch (c) {
+    case ' ': case '\t': case '\n': case '\r':
+    case ',': case ':': case '"':
+    case '[': case ']': case '{': case '}':
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+value_scanner::value_scanner(const kernel_table &kernels)
+    : _kernels(&kernels) {}
+
+const char *value_scanner::scan(const char *begin, const char *end) {
+  const auto *position = begin;
+  const auto offset_of = [&](const char *p) { return _offset + size_t(p - begin); };
+
+  while (position != end) {
+    switch (_state) {
+      case state::before_value: {
+        const auto c = *position;
+        if (is_whitespace(c)) {
+          position++;
+        } else if (c == '{' || c == '[') {
+          position++;
+          _stack.push(_inside);
+          _inside = c;
+          _state = state::in_container;
+        } else if (c == '"') {
+          position++;
+          _state = state::in_string;
+        } else if (c == '}' || c == ']' || c == ',' || c == ':') {
+          fail("Unexpected character", offset_of(position));
+        } else {
+          position++;
+          _state = state::in_scalar;
+        }
+        break;
+      }
+
+      case state::in_container: {
+        const auto c = *(position++);
+        if (c == '"') {
+          _state = state::in_string;
+        } else if (c == '{' || c == '[') {
+          _stack.push(_inside);
+          _inside = c;
+        } else if (c == '}' || c == ']') {
+          if (json_unlikely(c != _inside + 2)) {  // '{' + 2 == '}', '[' + 2 == ']'
+            fail(_inside == '{' ? "Expected '}'" : "Expected ']'", offset_of(position - 1));
+          }
+          _inside = _stack.pop();
+          _state = (_inside ? state::in_container : state::done);
+        }
+        break;
+      }
+
+      case state::in_string: {
+        decode_context context(position, end);
+        context.kernels = _kernels;
+        skip_any_simple_characters(context);
+        position = context.position;
+        if (position != end) {
+          if (*(position++) == '"') {
+            _state = (_inside ? state::in_container : state::done);
+          } else {
+            _state = state::in_string_escape;
+          }
+        }
+        break;
+      }
+
+      case state::in_string_escape:
+        position++;
+        _state = state::in_string;
+        break;
+
+      case state::in_scalar:
+        if (ends_scalar(*position)) {
+          _state = state::done;
+        } else {
+          position++;
+        }
+        break;
+
+      case state::done:
+        break;
+    }
+
+    if (_state == state::done) {
+      _offset = offset_of(position);
+      return position;
+    }
+  }
+
+  _offset = offset_of(position);
+  return nullptr;
+}
+
+bool value_scanner::finish() {
+  switch (_state) {
+    case state::before_value: return false;
+    case state::in_scalar: _state = state::done; return true;
+    case state::done: return true;
+    default: fail("Unexpected end of input", _offset);
+  }
+}
+
+void value_scanner::reset() {
+  _stack = stack<char, 64>();
+  _inside = 0;
+  _state = state::before_value;
+  _offset = 0;
+}
+
+void value_scanner::fail(const char *error, const std::size_t offset) const {
+  throw decode_exception(error, offset);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/document.hpp>
+
+#include <new>
+#include <stdexcept>
+
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/detail/stack.hpp>
+
+namespace spotify {
+namespace json {
+namespace {
+
+using detail::escaped_string;
+using detail::tape_entry;
+using detail::tape_tag;
+
+const char null_literal[] = "null";
+
+/**
+ * Append a string (or key) at context.position to the tape. The string is
+ * decoded with string_view_t, which returns a view of the input when there are
+ * no escape sequences and otherwise unescapes into context.memory_resource.
+ */
+json_force_inline void append_string(decode_context &context, std::vector<tape_entry> &tape) {
+  const auto content = context.position + 1;
+  const auto value = codec::string_view().decode(context);
+  if (json_likely(value.data() == content)) {
+    tape.emplace_back(tape_tag::string, value.size(), content);
+    return;
+  }
+
+  const auto source = std::string_view(content, context.position - 1 - content);
+  const auto memory = context.memory_resource->allocate(sizeof(escaped_string), alignof(escaped_string));
+  tape.emplace_back(tape_tag::escaped_string, value.size(), new (memory) escaped_string{ value, source });
+}
+
+json_force_inline void append_key(decode_context &context, std::vector<tape_entry> &tape) {
+  detail::skip_any_whitespace(context);
+  detail::fail_if(context, detail::peek(context) != '"', "Expected '\"'");
+  append_string(context, tape);
+  detail::skip_any_whitespace(context);
+  detail::skip_1(context, ':');
+}
+
+json_force_inline void append_scalar(decode_context &context, std::vector<tape_entry> &tape) {
+  const auto begin = context.position;
+  switch (detail::peek(context)) {
+    case '"':
+      append_string(context, tape);
+      return;
+    case '-':  // fallthrough
+    case '0': case '1': case '2': case '3': case '4':  // fallthrough
+    case '5': case '6': case '7': case '8': case '9':
+      detail::skip_number(context);
+      tape.emplace_back(tape_tag::number, context.position - begin, begin);
+      return;
+    case 't':
+      detail::skip_true(context);
+      tape.emplace_back(tape_tag::true_value, 0, begin);
+      return;
+    case 'f':
+      detail::skip_false(context);
+      tape.emplace_back(tape_tag::false_value, 0, begin);
+      return;
+    case 'n':
+      detail::skip_null(context);
+      tape.emplace_back(tape_tag::null_value, 0, begin);
+      return;
+    default:
+      detail::fail_if(context, !context.remaining(), "Unexpected end of input");
+      detail::fail(context, (std::string("Encountered token '") + detail::peek(context) + "'").c_str());
+  }
+}
+
+/**
+ * Append the close entry of the container whose open entry is at open_index,
+ * and point the open entry past it.
+ */
+json_force_inline void close_container(std::vector<tape_entry> &tape, const size_t open_index, const char *close) {
+  const auto index = tape.size();
+  const auto open_tag = tape[open_index].tag();
+  const auto close_tag = (open_tag == tape_tag::array_open ? tape_tag::array_close : tape_tag::object_close);
+  tape.emplace_back(close_tag, index - open_index, close);
+  tape[open_index] = tape_entry(open_tag, index + 1 - open_index, tape[open_index].pointer);
+}
+
+/**
+ * Append the entries of the JSON value at context.position to the tape, in
+ * one pass over the input. This follows the structure of parse_value, but
+ * keeps the tape indices of the open containers instead of their brackets.
+ */
+void build_tape(decode_context &context, std::vector<tape_entry> &tape) {
+  // inside is one more than the tape index of the innermost open container,
+  // so that zero means that no container is open.
+  detail::stack<size_t, 64> stack;
+  size_t inside = 0;
+
+  while (true) {
+    detail::skip_any_whitespace(context);
+    const auto c = detail::peek(context);
+    if (c == '{' || c == '[') {
+      const auto open_index = tape.size();
+      tape.emplace_back(c == '{' ? tape_tag::object_open : tape_tag::array_open, 0, context.position);
+      detail::skip_unchecked_1(context);
+
+      detail::skip_any_whitespace(context);
+      if (detail::peek(context) != char(c + 2)) {  // '{' + 2 == '}', '[' + 2 == ']'
+        stack.push(inside);
+        inside = open_index + 1;
+        if (c == '{') {
+          append_key(context, tape);
+        }
+        continue;
+      }
+
+      close_container(tape, open_index, context.position);
+      detail::skip_unchecked_1(context);
+    } else {
+      append_scalar(context, tape);
+    }
+
+    // A value has ended. Close all containers that end right after it.
+    while (true) {
+      if (!inside) {
+        return;
+      }
+
+      const auto is_object = (tape[inside - 1].tag() == tape_tag::object_open);
+      detail::skip_any_whitespace(context);
+      const auto n = detail::next(context, is_object ? "Expected '}'" : "Expected ']'");
+      if (n == ',') {
+        if (is_object) {
+          append_key(context, tape);
+        }
+        break;
+      }
+
+      detail::fail_if(context, n != (is_object ? '}' : ']'), is_object ? "Expected ',' or '}'" : "Expected ',' or ']'", -1);
+      close_container(tape, inside - 1, context.position - 1);
+      inside = stack.pop();
+    }
+  }
+}
+
+}  // namespace
+
+dom_type dom_value::type() const {
+  switch (_entry->tag()) {
+    case tape_tag::null_value: return dom_type::null;
+    case tape_tag::true_value:  // fallthrough
+    case tape_tag::false_value: return dom_type::boolean;
+    case tape_tag::number: return dom_type::number;
+    case tape_tag::string:  // fallthrough
+    case tape_tag::escaped_string: return dom_type::string;
+    case tape_tag::array_open: return dom_type::array;
+    case tape_tag::object_open: return dom_type::object;
+    default: json_unreachable();
+  }
+}
+
+bool dom_value::as_bool() const {
+  switch (_entry->tag()) {
+    case tape_tag::true_value: return true;
+    case tape_tag::false_value: return false;
+    default: throw std::invalid_argument("JSON value is not a boolean");
+  }
+}
+
+std::string_view dom_value::as_string() const {
+  switch (_entry->tag()) {
+    case tape_tag::string:
+      return std::string_view(static_cast<const char *>(_entry->pointer), _entry->payload());
+    case tape_tag::escaped_string:
+      return static_cast<const escaped_string *>(_entry->pointer)->value;
+    default:
+      throw std::invalid_argument("JSON value is not a string");
+  }
+}
+
+std::string_view dom_value::number_text() const {
+  if (json_unlikely(_entry->tag() != tape_tag::number)) {
+    throw std::invalid_argument("JSON value is not a number");
+  }
+  return std::string_view(static_cast<const char *>(_entry->pointer), _entry->payload());
+}
+
+double dom_value::as_double() const {
+  const auto text = number_text();
+  return json::decode(codec::number<double>(), text.data(), text.size());
+}
+
+int64_t dom_value::as_int64() const {
+  const auto text = number_text();
+  return json::decode(codec::number<int64_t>(), text.data(), text.size());
+}
+
+uint64_t dom_value::as_uint64() const {
+  const auto text = number_text();
+  return json::decode(codec::number<uint64_t>(), text.data(), text.size());
+}
+
+const tape_entry *dom_value::expect(const tape_tag open_tag, const char *message) const {
+  if (json_unlikely(_entry->tag() != open_tag)) {
+    throw std::invalid_argument(message);
+  }
+  return _entry;
+}
+
+size_t dom_value::size() const {
+  if (_entry->tag() == tape_tag::object_open) {
+    const auto members = this->members();
+    return std::distance(members.begin(), members.end());
+  } else {
+    const auto elements = this->elements();
+    return std::distance(elements.begin(), elements.end());
+  }
+}
+
+dom_value dom_value::operator[](const size_t index) const {
+  auto i = index;
+  for (const auto element : elements()) {
+    if (!i--) {
+      return element;
+    }
+  }
+  throw std::out_of_range("JSON array index out of range");
+}
+
+std::optional<dom_value> dom_value::find(const std::string_view key) const {
+  for (const auto member : members()) {
+    if (member.key == key) {
+      return member.value;
+    }
+  }
+  return std::nullopt;
+}
+
+dom_value dom_value::operator[](const std::string_view key) const {
+  if (const auto value = find(key)) {
+    return *value;
+  }
+  throw std::out_of_range("JSON object has no member '" + std::string(key) + "'");
+}
+
+dom_range<dom_value::array_iterator> dom_value::elements() const {
+  const auto open = expect(tape_tag::array_open, "JSON value is not an array");
+  const auto close = open + open->payload() - 1;
+  return dom_range<array_iterator>(array_iterator(open + 1), array_iterator(close));
+}
+
+dom_range<dom_value::object_iterator> dom_value::members() const {
+  const auto open = expect(tape_tag::object_open, "JSON value is not an object");
+  const auto close = open + open->payload() - 1;
+  return dom_range<object_iterator>(object_iterator(open + 1), object_iterator(close));
+}
+
+std::string_view dom_value::json() const {
+  const auto begin = static_cast<const char *>(_entry->pointer);
+  switch (_entry->tag()) {
+    case tape_tag::null_value: return std::string_view(begin, 4);
+    case tape_tag::true_value: return std::string_view(begin, 4);
+    case tape_tag::false_value: return std::string_view(begin, 5);
+    case tape_tag::number: return std::string_view(begin, _entry->payload());
+    case tape_tag::string: return std::string_view(begin - 1, _entry->payload() + 2);
+    case tape_tag::escaped_string: {
+      const auto source = static_cast<const escaped_string *>(_entry->pointer)->source;
+      return std::string_view(source.data() - 1, source.size() + 2);
+    }
+    default: {
+      const auto close = _entry + _entry->payload() - 1;
+      return std::string_view(begin, static_cast<const char *>(close->pointer) + 1 - begin);
+    }
+  }
+}
+
+document::document() {
+  _tape.emplace_back(tape_tag::null_value, 0, null_literal);
+}
+
+document::document(const char *data, const size_t size) {
+  decode_context context(data, size);
+  detail::skip_any_whitespace(context);
+  build(context);
+  detail::skip_any_whitespace(context);
+  detail::fail_if(context, context.position != context.end, "Unexpected trailing input");
+}
+
+document::document(std::string json)
+    : _source(std::make_unique<std::string>(std::move(json))) {
+  decode_context context(_source->data(), _source->size());
+  detail::skip_any_whitespace(context);
+  build(context);
+  detail::skip_any_whitespace(context);
+  detail::fail_if(context, context.position != context.end, "Unexpected trailing input");
+}
+
+document::document(decode_context &context) {
+  detail::skip_any_whitespace(context);
+  const auto begin = context.position;
+  build(context);
+
+  // The tape points into the input of the context. Copy the text of the value
+  // and move every pointer into the input over to the copy.
+  _source = std::make_unique<std::string>(begin, context.position);
+  const auto rebase = [&](const void *pointer) {
+    return _source->data() + (static_cast<const char *>(pointer) - begin);
+  };
+  for (auto &entry : _tape) {
+    if (entry.tag() == tape_tag::escaped_string) {
+      const auto string = static_cast<escaped_string *>(const_cast<void *>(entry.pointer));
+      string->source = std::string_view(rebase(string->source.data()), string->source.size());
+    } else {
+      entry.pointer = rebase(entry.pointer);
+    }
+  }
+}
+
+document::document(const document &other)
+    : document(std::string(other.root().json())) {}
+
+document &document::operator=(const document &other) {
+  return (*this = document(other));
+}
+
+void document::build(decode_context &context) {
+  // The arena does not allocate until the first string with escape sequences.
+  _arena = std::make_unique<std::pmr::monotonic_buffer_resource>();
+  decode_context tape_context(context);
+  tape_context.memory_resource = _arena.get();
+  build_tape(tape_context, _tape);
+  context.position = tape_context.position;
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -18,13 +18,12 @@
 
 #include <algorithm>
 #include <limits>
-#include <spotify/json/detail/cpuid.hpp>
 
 namespace spotify {
 namespace json {
 
 encode_context::encode_context(const std::size_t capacity)
-    : has_sse42(detail::cpuid().has_sse42()),
+    : kernels(&detail::default_kernel_table()),
       _buf(static_cast<char *>(capacity ? std::malloc(capacity) : nullptr)),
       _ptr(_buf),
       _end(_buf + capacity),
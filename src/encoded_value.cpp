@@ -18,7 +18,6 @@
 
 #include <algorithm>
 #include <limits>
-#include <spotify/json/detail/cpuid.hpp>
 
 namespace spotify {
 namespace json {
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/extract.hpp>
+
+#include <algorithm>
+
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/json_pointer.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+
+namespace spotify {
+namespace json {
+
+struct extractor::walk_state {
+  decode_context &context;
+  extracted_values &values;
+  size_t remaining;
+  std::string scratch;
+};
+
+extractor::extractor(const std::vector<std::string_view> &pointers)
+    : _nodes(1, node{ std::string(), json_size_t_max, {}, {} }),
+      _num_pointers(pointers.size()) {
+  for (size_t i = 0; i < pointers.size(); i++) {
+    size_t current = 0;
+    for (auto &token : detail::parse_json_pointer(pointers[i])) {
+      const auto &children = _nodes[current].children;
+      const auto child = std::find_if(children.begin(), children.end(), [&](const size_t child) {
+        return _nodes[child].token == token;
+      });
+
+      if (child != children.end()) {
+        current = *child;
+      } else {
+        const auto index = detail::parse_array_index(token);
+        _nodes.push_back(node{ std::move(token), index, {}, {} });
+        _nodes[current].children.push_back(_nodes.size() - 1);
+        current = _nodes.size() - 1;
+      }
+    }
+    _nodes[current].pointers.push_back(i);
+  }
+}
+
+extracted_values extractor::extract(const char *data, const size_t size) const {
+  extracted_values values(data, _num_pointers);
+  decode_context context(data, size);
+  walk_state state{ context, values, _num_pointers, std::string() };
+  detail::skip_any_whitespace(context);
+  if (_num_pointers) {
+    walk(state, _nodes.front());
+  }
+  return values;
+}
+
+extracted_values extractor::extract(const encoded_value_ref &json) const {
+  return extract(json.data(), json.size());
+}
+
+/**
+ * Walk the value at state.context.position, which current refers to, and
+ * record the values of the pointers that end at it or below it. Returns true
+ * when all pointers have been found, in which case the walk stops wherever it
+ * is. Since the pointers of current count as remaining until the value has
+ * been walked, the walk cannot stop inside of a value that is recorded.
+ */
+bool extractor::walk(walk_state &state, const node &current) const {
+  auto &context = state.context;
+  const auto begin = context.position;
+  const auto c = detail::peek(context);
+  if (c == '{' && !current.children.empty()) {
+    if (walk_object(state, current)) {
+      return true;
+    }
+  } else if (c == '[' && !current.children.empty()) {
+    if (walk_array(state, current)) {
+      return true;
+    }
+  } else {
+    detail::skip_value(context);
+  }
+
+  // Only the first value that a pointer refers to is recorded, in case an
+  // object has several members with the same key.
+  auto &values = state.values._values;
+  if (current.pointers.empty() || values[current.pointers.front()]) {
+    return false;
+  }
+
+  const auto value = encoded_value_ref(begin, context.position - begin, encoded_value_ref::unsafe_unchecked());
+  for (const auto pointer : current.pointers) {
+    values[pointer] = value;
+  }
+  state.remaining -= current.pointers.size();
+  return !state.remaining;
+}
+
+bool extractor::walk_object(walk_state &state, const node &current) const {
+  auto &context = state.context;
+  detail::skip_1(context, '{');
+  detail::skip_any_whitespace(context);
+  if (detail::peek(context) == '}') {
+    detail::skip_unchecked_1(context);
+    return false;
+  }
+
+  while (true) {
+    detail::fail_if(context, detail::peek(context) != '"', "Expected '\"'");
+    const auto key = detail::read_key(context, state.scratch);
+    const auto child = std::find_if(current.children.begin(), current.children.end(), [&](const size_t child) {
+      return _nodes[child].token == key;
+    });
+
+    detail::skip_any_whitespace(context);
+    detail::skip_1(context, ':');
+    detail::skip_any_whitespace(context);
+    if (child == current.children.end()) {
+      detail::skip_value(context);
+    } else if (walk(state, _nodes[*child])) {
+      return true;
+    }
+
+    detail::skip_any_whitespace(context);
+    const auto n = detail::next(context, "Expected '}'");
+    if (n == '}') {
+      return false;
+    }
+    detail::fail_if(context, n != ',', "Expected ',' or '}'", -1);
+    detail::skip_any_whitespace(context);
+  }
+}
+
+bool extractor::walk_array(walk_state &state, const node &current) const {
+  auto &context = state.context;
+  detail::skip_1(context, '[');
+  detail::skip_any_whitespace(context);
+  if (detail::peek(context) == ']') {
+    detail::skip_unchecked_1(context);
+    return false;
+  }
+
+  for (size_t i = 0;; i++) {
+    const auto child = std::find_if(current.children.begin(), current.children.end(), [&](const size_t child) {
+      return _nodes[child].index == i;
+    });
+
+    if (child == current.children.end()) {
+      detail::skip_value(context);
+    } else if (walk(state, _nodes[*child])) {
+      return true;
+    }
+
+    detail::skip_any_whitespace(context);
+    const auto n = detail::next(context, "Expected ']'");
+    if (n == ']') {
+      return false;
+    }
+    detail::fail_if(context, n != ',', "Expected ',' or ']'", -1);
+    detail::skip_any_whitespace(context);
+  }
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <spotify/json/mapped_file.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#define json_no_mmap
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // defined(_WIN32)
+
+namespace spotify {
+namespace json {
+namespace {
+
+json_noreturn void throw_system_error(const char *what, const std::string &path, int error = errno) {
+  throw std::system_error(error, std::generic_category(), std::string(what) + " " + path);
+}
+
+}  // namespace
+
+#if defined(json_no_mmap)
+
+mapped_file::mapped_file(const std::string &path, const mapped_file_options &) {
+  std::unique_ptr<FILE, decltype(&std::fclose)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+  if (!file) {
+    throw_system_error("Could not open", path);
+  }
+
+  // The 64 bit variants, since files of several GB are what this is for
+  _fseeki64(file.get(), 0, SEEK_END);
+  const auto size = _ftelli64(file.get());
+  _fseeki64(file.get(), 0, SEEK_SET);
+  if (size < 0) {
+    throw_system_error("Could not read", path);
+  }
+  if (size == 0) {
+    return;
+  }
+
+  const auto data = static_cast<char *>(std::malloc(size_t(size)));
+  if (!data) {
+    throw std::bad_alloc();
+  }
+  if (std::fread(data, 1, size_t(size), file.get()) != size_t(size)) {
+    const auto error = errno;
+    std::free(data);
+    throw_system_error("Could not read", path, error);
+  }
+
+  _data = data;
+  _size = size_t(size);
+  _mapped = true;
+}
+
+void mapped_file::unmap() noexcept {
+  if (_mapped) {
+    std::free(const_cast<char *>(_data));
+  }
+}
+
+#else
+
+mapped_file::mapped_file(const std::string &path, const mapped_file_options &options) {
+  const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw_system_error("Could not open", path);
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    throw_system_error("Could not stat", path, error);
+  }
+
+  const auto size = static_cast<std::size_t>(info.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return;  // mmap does not map empty files
+  }
+
+  auto flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  if (options.populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif  // defined(MAP_POPULATE)
+
+  const auto address = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+  const auto error = errno;
+  ::close(fd);  // the mapping keeps the file open
+  if (address == MAP_FAILED) {
+    throw_system_error("Could not map", path, error);
+  }
+
+  // The advice is only a hint, so failures are ignored.
+  if (options.sequential) {
+    ::madvise(address, size, MADV_SEQUENTIAL);
+  }
+  if (options.will_need) {
+    ::madvise(address, size, MADV_WILLNEED);
+  }
+#if defined(MADV_HUGEPAGE)
+  if (options.huge_pages) {
+    ::madvise(address, size, MADV_HUGEPAGE);
+  }
+#endif  // defined(MADV_HUGEPAGE)
+
+  _data = static_cast<const char *>(address);
+  _size = size;
+  _mapped = true;
+}
+
+void mapped_file::unmap() noexcept {
+  if (_mapped) {
+    ::munmap(const_cast<char *>(_data), _size);
+  }
+}
+
+#endif  // defined(json_no_mmap)
+
+mapped_file::mapped_file(mapped_file &&file) noexcept {
+  swap(file);
+}
+
+mapped_file &mapped_file::operator=(mapped_file &&file) noexcept {
+  mapped_file new_file(std::move(file));
+  swap(new_file);
+  return *this;
+}
+
+mapped_file::~mapped_file() {
+  unmap();
+}
+
+void mapped_file::swap(mapped_file &file) noexcept {
+  std::swap(_data, file._data);
+  std::swap(_size, file._size);
+  std::swap(_mapped, file._mapped);
+}
+
+mapped_encoded_value::mapped_encoded_value(const std::string &path, const mapped_file_options &options)
+    : mapped_encoded_value(path, options, unsafe_unchecked()) {
+  validate_json(data(), size());
+}
+
+mapped_encoded_value::mapped_encoded_value(
+    const std::string &path,
+    const mapped_file_options &options,
+    const unsafe_unchecked &)
+    : _file(path, options) {}
+
+}  // namespace json
+}  // namespace spotify
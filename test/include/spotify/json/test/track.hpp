@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A small object type for the tests of the decoding entry points, with a
+ * required string and an optional array.
+ */
+struct track_t {
+  std::string uri;
+  std::vector<int> ratings;
+};
+
+inline codec::object_t<track_t> track_codec() {
+  codec::object_t<track_t> codec;
+  codec.required("uri", &track_t::uri);
+  codec.optional("ratings", &track_t::ratings);
+  return codec;
+}
+
+}  // namespace json
+}  // namespace spotify
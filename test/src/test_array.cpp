@@ -15,6 +15,7 @@
  */
 
 #include <string>
+#include <memory_resource>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -24,6 +25,7 @@
 #include <spotify/json/codec/boolean.hpp>
 #include <spotify/json/codec/number.hpp>
 #include <spotify/json/codec/omit.hpp>
+#include <spotify/json/codec/string.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/encode.hpp>
 
@@ -231,6 +233,32 @@ BOOST_AUTO_TEST_CASE(json_codec_array_should_decode_empty_unordered_set) {
   BOOST_CHECK(array_parse<std::unordered_set<bool>>("[]").empty());
 }
 
+/*
+ * pmr Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_array_should_decode_pmr_vector_from_memory_resource) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"(["a","b\n",""])";
+  decode_context context(json.data(), json.size());
+  context.memory_resource = &arena;
+
+  const auto vector = default_codec<std::pmr::vector<std::pmr::string>>().decode(context);
+  BOOST_REQUIRE_EQUAL(vector.size(), 3);
+  BOOST_CHECK(vector.get_allocator().resource() == &arena);
+  BOOST_CHECK(vector[1].get_allocator().resource() == &arena);
+  BOOST_CHECK_EQUAL(vector[0], "a");
+  BOOST_CHECK_EQUAL(vector[1], "b\n");
+  BOOST_CHECK_EQUAL(vector[2], "");
+  BOOST_CHECK_EQUAL(encode(vector), json);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_array_should_decode_pmr_vector_without_memory_resource) {
+  const auto vector = array_parse<std::pmr::vector<bool>>("[true,false]");
+  BOOST_CHECK(vector.get_allocator().resource() == std::pmr::get_default_resource());
+  BOOST_CHECK_EQUAL(vector.size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
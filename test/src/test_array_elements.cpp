@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/array_elements.hpp>
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+
+#include <spotify/json/test/track.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+template <typename value_type>
+std::vector<value_type> collect(const std::string &json, const char *pointer = "") {
+  std::vector<value_type> values;
+  for (const auto &value : array_elements<value_type>(json, pointer)) {
+    values.push_back(value);
+  }
+  return values;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_iterate_over_top_level_array) {
+  BOOST_CHECK(collect<int>(" [ 1 , 2,3 ] ") == std::vector<int>({ 1, 2, 3 }));
+  BOOST_CHECK(collect<int>("[]").empty());
+  BOOST_CHECK(collect<int>("[ ]").empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_iterate_over_array_at_pointer) {
+  const std::string json = R"({
+    "skipped": {"tracks": [0]},
+    "catalog": {"name": "x", "a/b": [[4], [5, 6]], "~": [7]}
+  })";
+  BOOST_CHECK(collect<int>(json, "/catalog/a~1b/1") == std::vector<int>({ 5, 6 }));
+  BOOST_CHECK(collect<int>(json, "/catalog/~0") == std::vector<int>({ 7 }));
+  BOOST_CHECK(collect<std::vector<int>>(json, "/catalog/a~1b") ==
+              std::vector<std::vector<int>>({ { 4 }, { 5, 6 } }));
+}
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_decode_with_codec) {
+  const std::string json = R"([{"uri":"a","ratings":[1,2]},{"uri":"b"}])";
+  std::vector<std::string> uris;
+  std::vector<size_t> num_ratings;
+  for (const auto &track : array_elements(track_codec(), json)) {
+    uris.push_back(track.uri);
+    num_ratings.push_back(track.ratings.size());
+  }
+  BOOST_CHECK(uris == std::vector<std::string>({ "a", "b" }));
+  BOOST_CHECK(num_ratings == std::vector<size_t>({ 2, 0 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_stop_reading_after_array) {
+  BOOST_CHECK(collect<int>(R"({"a":[1],"b":)", "/a") == std::vector<int>({ 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_fail_when_pointer_is_not_found) {
+  const std::string json = R"({"a":{"b":[1]},"c":[]})";
+  BOOST_CHECK_THROW(collect<int>(json, "/x"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>(json, "/a/x"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>(json, "/a/b/1"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>(json, "/c/0"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>(json, "/c/x"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>(json, "/a/b/0/x"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>(json, "/a"), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_fail_on_invalid_pointer) {
+  BOOST_CHECK_THROW(collect<int>("[]", "a"), std::invalid_argument);
+  BOOST_CHECK_THROW(collect<int>("[]", "/~2"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(json_array_elements_should_fail_on_invalid_elements) {
+  const std::string json = "[1,2,x]";
+  auto elements = array_elements<int>(json);
+  auto it = elements.begin();
+  BOOST_CHECK_EQUAL(*it, 1);
+  ++it;
+  BOOST_CHECK_EQUAL(*it, 2);
+  BOOST_CHECK_THROW(++it, decode_exception);
+
+  BOOST_CHECK_THROW(collect<int>("[1,2"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>("[1,]"), decode_exception);
+  BOOST_CHECK_THROW(collect<int>("[1 2]"), decode_exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/any_value.hpp>
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/cursor.hpp>
+#include <spotify/json/decode_exception.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+const std::string body = R"( {
+  "user": { "name": "nåme", "id": 1234 },
+  "tracks": [ { "uri": "a" }, { "uri": "b" } ],
+  "k\/ey": true,
+  "none": null
+} )";
+
+size_t expect_offset(const std::function<void ()> &function) {
+  try {
+    function();
+  } catch (const decode_exception &exception) {
+    return exception.offset();
+  }
+  BOOST_FAIL("Expected a decode_exception");
+  return 0;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_read_members) {
+  const cursor root(body.data(), body.size());
+  BOOST_CHECK_EQUAL(root["user"]["id"].get<int64_t>(), 1234);
+  BOOST_CHECK_EQUAL(root["user"]["name"].get<std::string>(), "n\xc3\xa5me");
+  BOOST_CHECK_EQUAL(root["tracks"][1]["uri"].get<std::string>(), "b");
+  BOOST_CHECK_EQUAL(root["k/ey"].get(codec::boolean()), true);
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_read_from_encoded_value_refs) {
+  const encoded_value json(R"({"tracks":[{"uri":"a"}]})");
+  BOOST_CHECK_EQUAL(cursor(json)["tracks"][0]["uri"].get<std::string>(), "a");
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_find_members) {
+  const cursor root(body.data(), body.size());
+  BOOST_CHECK(!root["user"].is_null());
+  BOOST_CHECK(root["none"].is_null());
+  BOOST_CHECK(root.find("user"));
+  BOOST_CHECK(!root.find("missing"));
+  BOOST_CHECK(!root["user"].find("missing"));
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_find_members_in_any_order) {
+  const cursor root(body.data(), body.size());
+  const std::vector<std::string> keys = { "tracks", "none", "user", "none", "none", "user", "tracks" };
+  for (const auto &key : keys) {
+    BOOST_CHECK_EQUAL(root[key].offset(), body.find(":", body.find(key + "\"")) + 2);
+  }
+  BOOST_CHECK(!root.find("missing"));
+  BOOST_CHECK_EQUAL(root["tracks"][0]["uri"].get<std::string>(), "a");
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_read_pointers) {
+  const cursor root(body.data(), body.size());
+  BOOST_CHECK_EQUAL(root.at_pointer("/tracks/1/uri").get<std::string>(), "b");
+  BOOST_CHECK_EQUAL(root["tracks"].at_pointer("/0/uri").get<std::string>(), "a");
+  BOOST_CHECK_THROW(root.at_pointer("tracks"), std::invalid_argument);
+  BOOST_CHECK_THROW(root.at_pointer("/tracks/2"), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_return_the_text_of_values) {
+  const cursor root(body.data(), body.size());
+  BOOST_CHECK_EQUAL(std::string(root["tracks"][0].json().data(), root["tracks"][0].json().size()), R"({ "uri": "a" })");
+  BOOST_CHECK_EQUAL(root["user"]["id"].offset(), body.find("1234"));
+  BOOST_CHECK(root["tracks"].get<std::vector<encoded_value>>().size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_be_reusable) {
+  const cursor user = cursor(body.data(), body.size())["user"];
+  BOOST_CHECK_EQUAL(user["id"].get<int>(), 1234);
+  BOOST_CHECK_EQUAL(user["name"].get<std::string>(), "n\xc3\xa5me");
+  BOOST_CHECK_EQUAL(user["id"].get<int>(), 1234);
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_not_read_past_the_requested_value) {
+  const std::string json = R"({"a":1,"b":[1,2,}})";
+  const cursor root(json.data(), json.size());
+  BOOST_CHECK_EQUAL(root["a"].get<int>(), 1);
+  BOOST_CHECK_THROW(root["b"].json(), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_fail_with_offsets) {
+  const cursor root(body.data(), body.size());
+  BOOST_CHECK_EQUAL(expect_offset([&]{ root["missing"]; }), body.find('{'));
+  BOOST_CHECK_EQUAL(expect_offset([&]{ root["tracks"][2]; }), body.find('['));
+  BOOST_CHECK_EQUAL(expect_offset([&]{ root["tracks"]["uri"]; }), body.find('['));
+  BOOST_CHECK_EQUAL(expect_offset([&]{ root["user"][0]; }), body.find("{ \"name\""));
+  BOOST_CHECK_EQUAL(expect_offset([&]{ root["user"]["id"].get<std::string>(); }), body.find("1234"));
+}
+
+BOOST_AUTO_TEST_CASE(json_cursor_should_fail_on_empty_containers) {
+  const std::string json = R"({"a":{},"b":[]})";
+  const cursor root(json.data(), json.size());
+  BOOST_CHECK(!root["a"].find("x"));
+  BOOST_CHECK_THROW(root["b"][0], decode_exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
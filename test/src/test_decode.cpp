@@ -15,9 +15,11 @@
  */
 
 #include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/array.hpp>
 #include <spotify/json/codec/number.hpp>
 #include <spotify/json/codec/object.hpp>
 #include <spotify/json/decode.hpp>
@@ -223,5 +225,35 @@ BOOST_AUTO_TEST_CASE(json_try_decode_should_accept_utf8) {
   BOOST_CHECK_EQUAL(u8"\u9E21", obj.val);
 }
 
+BOOST_AUTO_TEST_CASE(json_decode_into_should_decode_with_custom_codec) {
+  static const char * const kData = R"({"a":"e"})";
+  custom_obj obj;
+  decode_into(custom_codec(), kData, strlen(kData), obj);
+  BOOST_CHECK_EQUAL(obj.val, "e");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_into_should_decode_from_string) {
+  custom_obj obj;
+  obj.val = "a value that is long enough to be allocated on the heap";
+  const auto capacity = obj.val.capacity();
+  decode_into(std::string(R"({"x":"e"})"), obj);
+  BOOST_CHECK_EQUAL(obj.val, "e");
+  BOOST_CHECK_EQUAL(obj.val.capacity(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_into_should_keep_vector_capacity) {
+  static const char * const kData = " [1,2] ";
+  std::vector<int> vector{ 5, 4, 3, 2, 1 };
+  const auto data = vector.data();
+  decode_into(kData, strlen(kData), vector);
+  BOOST_CHECK(vector == std::vector<int>({ 1, 2 }));
+  BOOST_CHECK(vector.data() == data);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_into_should_fail_on_unexpected_trailing_input) {
+  int value = 0;
+  BOOST_CHECK_THROW(decode_into(std::string("1 1"), value), decode_exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <deque>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_batch.hpp>
+
+#include <spotify/json/test/track.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+BOOST_AUTO_TEST_CASE(json_decode_batch_should_decode_records_in_order) {
+  const std::vector<std::string> records = {
+    R"({"uri":"a"})",
+    R"( {"uri":"b","ratings":[1,2]} )",
+    R"({"uri":"c"})"
+  };
+
+  std::vector<track_t> tracks;
+  const auto errors = decode_batch(track_codec(), records, std::back_inserter(tracks));
+  BOOST_CHECK(errors.empty());
+  BOOST_REQUIRE_EQUAL(tracks.size(), 3);
+  BOOST_CHECK_EQUAL(tracks[0].uri, "a");
+  BOOST_CHECK_EQUAL(tracks[1].uri, "b");
+  BOOST_CHECK(tracks[1].ratings == std::vector<int>({ 1, 2 }));
+  BOOST_CHECK_EQUAL(tracks[2].uri, "c");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_batch_should_decode_empty_batch) {
+  std::vector<int> values;
+  BOOST_CHECK(decode_batch<int>(std::vector<std::string>(), std::back_inserter(values)).empty());
+  BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_batch_should_decode_with_default_codec) {
+  const std::list<std::string_view> records = { "1", " 2", "3 " };
+  std::deque<int> values;
+  BOOST_CHECK(decode_batch<int>(records, std::back_inserter(values)).empty());
+  BOOST_CHECK(values == std::deque<int>({ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_batch_should_report_errors_per_record) {
+  const std::vector<std::string> records = {
+    R"({"uri":"a"})",
+    R"({"uri":1})",
+    R"({"uri":"c"})",
+    R"({"uri":"d"} x)",
+    "",
+    R"({"uri":"f"})"
+  };
+
+  std::vector<track_t> tracks;
+  const auto errors = decode_batch(track_codec(), records, std::back_inserter(tracks));
+  BOOST_REQUIRE_EQUAL(tracks.size(), 3);
+  BOOST_CHECK_EQUAL(tracks[0].uri, "a");
+  BOOST_CHECK_EQUAL(tracks[1].uri, "c");
+  BOOST_CHECK_EQUAL(tracks[2].uri, "f");
+
+  BOOST_REQUIRE_EQUAL(errors.size(), 3);
+  BOOST_CHECK_EQUAL(errors[0].index, 1);
+  BOOST_CHECK_EQUAL(errors[0].offset, 7);
+  BOOST_CHECK_EQUAL(errors[1].index, 3);
+  BOOST_CHECK_EQUAL(errors[1].offset, 12);
+  BOOST_CHECK_EQUAL(errors[1].message, "Unexpected trailing input");
+  BOOST_CHECK_EQUAL(errors[2].index, 4);
+  BOOST_CHECK_EQUAL(errors[2].offset, 0);
+  BOOST_CHECK_EQUAL(errors[2].message, "Unexpected end of input");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_batch_should_report_whitespace_records) {
+  const std::vector<std::string> records = { " \n\t", "1", "2 \n" };
+  std::vector<int> values;
+  const auto errors = decode_batch<int>(records, std::back_inserter(values));
+  BOOST_CHECK(values == std::vector<int>({ 1, 2 }));
+  BOOST_REQUIRE_EQUAL(errors.size(), 1);
+  BOOST_CHECK_EQUAL(errors[0].index, 0);
+  BOOST_CHECK_EQUAL(errors[0].offset, 3);
+  BOOST_CHECK_EQUAL(errors[0].message, "Unexpected end of input");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_batch_should_decode_without_prefetch) {
+  const std::vector<std::string> records = { "1", "x", "3" };
+  decode_batch_options options;
+  options.prefetch = false;
+
+  std::vector<int> values;
+  const auto errors = decode_batch(codec::number<int>(), records.begin(), records.end(), std::back_inserter(values), options);
+  BOOST_CHECK(values == std::vector<int>({ 1, 3 }));
+  BOOST_REQUIRE_EQUAL(errors.size(), 1);
+  BOOST_CHECK_EQUAL(errors[0].index, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
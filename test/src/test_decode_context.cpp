@@ -45,6 +45,14 @@ BOOST_AUTO_TEST_CASE(json_decode_context_should_construct_with_data_size) {
   BOOST_CHECK(ctx.end == end);
 }
 
+BOOST_AUTO_TEST_CASE(json_decode_context_should_derive_has_sse42_from_kernels) {
+  decode_context ctx("", size_t(0));
+  ctx.kernels = &kernel_table_for(kernel_tier::scalar);
+  BOOST_CHECK(!ctx.has_sse42());
+  ctx.kernels = &default_kernel_table();
+  BOOST_CHECK_EQUAL(ctx.has_sse42(), default_kernel_table().tier >= kernel_tier::sse42);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
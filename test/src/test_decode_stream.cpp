@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_stream.hpp>
+
+#include <spotify/json/test/track.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+decode_stream_options options_with_threads(const size_t num_threads, const size_t batch_size = 1) {
+  decode_stream_options options;
+  options.num_threads = num_threads;
+  options.batch_size = batch_size;
+  return options;
+}
+
+std::string make_ndjson(const size_t num_records) {
+  std::string json;
+  for (size_t i = 0; i < num_records; i++) {
+    json += R"({"uri":"spotify:track:)" + std::to_string(i) + R"(","ratings":[)";
+    json += std::to_string(i) + "]}\n";
+  }
+  return json;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_decode_ndjson) {
+  const auto tracks = decode_stream(track_codec(), std::string(
+      "{\"uri\":\"a\"}\n"
+      "{\"uri\":\"b\",\"ratings\":[1,2]}\n"));
+  BOOST_REQUIRE_EQUAL(tracks.size(), 2);
+  BOOST_CHECK_EQUAL(tracks[0].uri, "a");
+  BOOST_CHECK_EQUAL(tracks[1].uri, "b");
+  BOOST_CHECK(tracks[1].ratings == std::vector<int>({ 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_decode_concatenated_json) {
+  const auto tracks = decode_stream(track_codec(), std::string(R"({"uri":"a"}{"uri":"b"})"));
+  BOOST_REQUIRE_EQUAL(tracks.size(), 2);
+  BOOST_CHECK_EQUAL(tracks[0].uri, "a");
+  BOOST_CHECK_EQUAL(tracks[1].uri, "b");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_decode_pretty_printed_json) {
+  const auto tracks = decode_stream(track_codec(), std::string(
+      "{\n  \"uri\": \"a\",\n  \"ratings\": [\n    1\n  ]\n}\n\n"
+      "  {\n  \"uri\": \"}\"\n}  "));
+  BOOST_REQUIRE_EQUAL(tracks.size(), 2);
+  BOOST_CHECK_EQUAL(tracks[0].uri, "a");
+  BOOST_CHECK(tracks[0].ratings == std::vector<int>({ 1 }));
+  BOOST_CHECK_EQUAL(tracks[1].uri, "}");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_decode_scalars) {
+  BOOST_CHECK(decode_stream<int>(std::string("1 2\n3")) == std::vector<int>({ 1, 2, 3 }));
+  BOOST_CHECK(decode_stream<std::string>(std::string(R"("a""b" "c\"")")) ==
+              std::vector<std::string>({ "a", "b", "c\"" }));
+  BOOST_CHECK(decode_stream<std::vector<int>>(std::string("[1][][2,3]")) ==
+              std::vector<std::vector<int>>({ { 1 }, {}, { 2, 3 } }));
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_decode_empty_input) {
+  BOOST_CHECK(decode_stream<int>(std::string()).empty());
+  BOOST_CHECK(decode_stream<int>(std::string(" \n\t\r\n")).empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_keep_order_with_many_threads) {
+  const auto json = make_ndjson(1000);
+  for (const auto num_threads : { 1, 2, 4, 0 }) {
+    const auto tracks = decode_stream(track_codec(), json, options_with_threads(num_threads, 7));
+    BOOST_REQUIRE_EQUAL(tracks.size(), 1000);
+    for (size_t i = 0; i < tracks.size(); i++) {
+      BOOST_CHECK_EQUAL(tracks[i].uri, "spotify:track:" + std::to_string(i));
+      BOOST_CHECK(tracks[i].ratings == std::vector<int>({ int(i) }));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_call_callback_once_per_record) {
+  const auto json = make_ndjson(100);
+  std::vector<std::atomic<int>> calls(100);
+  decode_stream(track_codec(), json.data(), json.size(), [&](const size_t index, track_t &&track) {
+    BOOST_REQUIRE_EQUAL(track.uri, "spotify:track:" + std::to_string(index));
+    calls[index]++;
+  }, options_with_threads(4));
+
+  for (const auto &count : calls) {
+    BOOST_CHECK_EQUAL(count.load(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_fail_with_offset_of_invalid_record) {
+  const std::string json = "{\"uri\":\"a\"}\n{\"uri\":1}\n{\"uri\":\"b\"}\n";
+  for (const auto num_threads : { 1, 4 }) {
+    try {
+      decode_stream(track_codec(), json, options_with_threads(num_threads));
+      BOOST_FAIL("decode_stream should have failed");
+    } catch (const decode_exception &exception) {
+      BOOST_CHECK_EQUAL(exception.offset(), 19);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_fail_with_first_invalid_record) {
+  auto json = make_ndjson(200);
+  json += "{}\n";
+  json += make_ndjson(200);
+  json += "{}\n";
+  const auto first_offset = make_ndjson(200).size() + 2;  // after the first "{}"
+  for (const auto num_threads : { 1, 4 }) {
+    BOOST_CHECK_EXCEPTION(
+        decode_stream(track_codec(), json, options_with_threads(num_threads)),
+        decode_exception,
+        [&](const decode_exception &exception) { return exception.offset() == first_offset; });
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_fail_on_unterminated_record) {
+  BOOST_CHECK_THROW(decode_stream<std::vector<int>>(std::string("[1]\n[2")), decode_exception);
+  BOOST_CHECK_THROW(decode_stream<std::string>(std::string("\"a\" \"b")), decode_exception);
+  BOOST_CHECK_THROW(decode_stream<int>(std::string("1 ]")), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_fail_on_trailing_input_after_scalar) {
+  BOOST_CHECK_THROW(decode_stream<int>(std::string("1\n2x\n3")), decode_exception);
+  BOOST_CHECK_THROW(decode_stream<bool>(std::string("truex")), decode_exception);
+  BOOST_CHECK_THROW(decode_stream<double>(std::string("1.5.5")), decode_exception);
+  BOOST_CHECK_EXCEPTION(
+      decode_stream<int>(std::string("1\n2x\n3")),
+      decode_exception,
+      [](const decode_exception &exception) { return exception.offset() == 3; });
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_stream_should_fail_on_trailing_input_after_object) {
+  const std::string json = "{\"uri\":\"a\"}\n{\"uri\":\"b\"}x\n";
+  for (const auto num_threads : { 1, 4 }) {
+    BOOST_CHECK_EXCEPTION(
+        decode_stream(track_codec(), json, options_with_threads(num_threads)),
+        decode_exception,
+        [](const decode_exception &exception) { return exception.offset() == 23; });
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
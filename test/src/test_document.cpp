@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/document.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/document.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct route_t {
+  std::string type;
+  document payload;
+};
+
+codec::object_t<route_t> route_codec() {
+  auto codec = codec::object<route_t>();
+  codec.required("type", &route_t::type);
+  codec.required("payload", &route_t::payload);
+  return codec;
+}
+
+bool points_into(const std::string_view view, const std::string &json) {
+  return view.data() >= json.data() && view.data() + view.size() <= json.data() + json.size();
+}
+
+}  // namespace
+
+/*
+ * Building
+ */
+
+BOOST_AUTO_TEST_CASE(json_document_should_parse_scalars) {
+  BOOST_CHECK(document(std::string("null")).root().is_null());
+  BOOST_CHECK_EQUAL(document(std::string("true")).root().as_bool(), true);
+  BOOST_CHECK_EQUAL(document(std::string("false")).root().as_bool(), false);
+  BOOST_CHECK_EQUAL(document(std::string(" \"abc\" ")).root().as_string(), "abc");
+  BOOST_CHECK_EQUAL(document(std::string("-1.5e3")).root().number_text(), "-1.5e3");
+  BOOST_CHECK_EQUAL(document(std::string("-1.5e3")).root().as_double(), -1500.0);
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_report_types) {
+  const document doc(std::string(R"([null,true,1,"a",[],{}])"));
+  std::vector<dom_type> types;
+  for (const auto element : doc.root().elements()) {
+    types.push_back(element.type());
+  }
+  BOOST_CHECK(types == std::vector<dom_type>({
+      dom_type::null, dom_type::boolean, dom_type::number,
+      dom_type::string, dom_type::array, dom_type::object }));
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_use_one_tape_entry_per_token) {
+  // [ {  "a"  1  }  "b"  ]
+  const document doc(std::string(R"([{"a":1},"b"])"));
+  BOOST_CHECK_EQUAL(doc.tape_size(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_be_null_by_default) {
+  const document doc;
+  BOOST_CHECK(doc.root().is_null());
+  BOOST_CHECK_EQUAL(doc.root().json(), "null");
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_refer_to_borrowed_input) {
+  const std::string json = R"({"a":"b","c":12})";
+  const document doc(json.data(), json.size());
+  BOOST_CHECK(points_into(doc.root()["a"].as_string(), json));
+  BOOST_CHECK(points_into(doc.root()["c"].number_text(), json));
+  BOOST_CHECK(points_into(doc.root().members().begin().operator*().key, json));
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_handle_deep_nesting) {
+  const auto depth = 1000;
+  const auto json = std::string(depth, '[') + "1" + std::string(depth, ']');
+  const document doc(json.data(), json.size());
+
+  auto value = doc.root();
+  for (int i = 0; i < depth; i++) {
+    BOOST_REQUIRE(value.is_array());
+    BOOST_REQUIRE_EQUAL(value.size(), 1);
+    value = value[0];
+  }
+  BOOST_CHECK_EQUAL(value.as_int64(), 1);
+  BOOST_CHECK_EQUAL(doc.root().json(), json);
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_fail_on_invalid_json) {
+  const auto parse = [](const std::string &json) { return document(json.data(), json.size()); };
+  BOOST_CHECK_THROW(parse(""), decode_exception);
+  BOOST_CHECK_THROW(parse("["), decode_exception);
+  BOOST_CHECK_THROW(parse("[1,]"), decode_exception);
+  BOOST_CHECK_THROW(parse("{\"a\"}"), decode_exception);
+  BOOST_CHECK_THROW(parse("{1:2}"), decode_exception);
+  BOOST_CHECK_THROW(parse("[1}"), decode_exception);
+  BOOST_CHECK_THROW(parse("nul"), decode_exception);
+  BOOST_CHECK_THROW(parse("\"\\x\""), decode_exception);
+  BOOST_CHECK_THROW(parse("1 2"), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_report_error_offsets) {
+  const std::string json = R"({"a":[1,2,x]})";
+  try {
+    document(json.data(), json.size());
+    BOOST_FAIL("Expected a decode_exception");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), json.find('x'));
+  }
+}
+
+/*
+ * Strings
+ */
+
+BOOST_AUTO_TEST_CASE(json_document_should_unescape_strings_into_the_arena) {
+  const std::string json = R"({"k\u00e5y":"a\"b\n"})";
+  const document doc(json.data(), json.size());
+  const auto member = *doc.root().members().begin();
+  BOOST_CHECK_EQUAL(member.key, "k\xc3\xa5y");
+  BOOST_CHECK_EQUAL(member.value.as_string(), "a\"b\n");
+  BOOST_CHECK(!points_into(member.value.as_string(), json));
+  BOOST_CHECK_EQUAL(member.value.json(), R"("a\"b\n")");
+  BOOST_CHECK(doc.root().find("k\xc3\xa5y"));
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_keep_empty_strings) {
+  const document doc(std::string(R"(["",""])"));
+  BOOST_CHECK_EQUAL(doc.root()[1].as_string(), "");
+  BOOST_CHECK_EQUAL(doc.root()[1].json(), "\"\"");
+}
+
+/*
+ * Navigation
+ */
+
+BOOST_AUTO_TEST_CASE(json_document_should_find_members) {
+  const document doc(std::string(R"({"a":{"x":[1,2,3]},"b":[{"c":true}],"d":null})"));
+  const auto root = doc.root();
+  BOOST_CHECK_EQUAL(root.size(), 3);
+  BOOST_CHECK_EQUAL(root["a"]["x"][2].as_int64(), 3);
+  BOOST_CHECK_EQUAL(root["b"][0]["c"].as_bool(), true);
+  BOOST_CHECK(root["d"].is_null());
+  BOOST_CHECK(!root.find("e"));
+  BOOST_CHECK(root.find("b") == root["b"]);
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_iterate_members_in_order) {
+  const document doc(std::string(R"({"b":[1,[2]],"a":{"c":{}},"b":3})"));
+  std::vector<std::string> keys;
+  for (const auto member : doc.root().members()) {
+    keys.emplace_back(member.key);
+  }
+  BOOST_CHECK(keys == std::vector<std::string>({ "b", "a", "b" }));
+  BOOST_CHECK_EQUAL(doc.root()["b"].json(), "[1,[2]]");
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_iterate_elements) {
+  const document doc(std::string(R"([ 1 , [ 2 , 3 ] , { "a" : 4 } , 5 ])"));
+  std::vector<std::string> elements;
+  for (const auto element : doc.root().elements()) {
+    elements.emplace_back(element.json());
+  }
+  BOOST_CHECK(elements == std::vector<std::string>({ "1", "[ 2 , 3 ]", R"({ "a" : 4 })", "5" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_convert_numbers) {
+  const document doc(std::string(R"([18446744073709551615,-9223372036854775808,0.25])"));
+  BOOST_CHECK_EQUAL(doc.root()[0].as_uint64(), UINT64_MAX);
+  BOOST_CHECK_EQUAL(doc.root()[1].as_int64(), INT64_MIN);
+  BOOST_CHECK_EQUAL(doc.root()[2].as_double(), 0.25);
+  BOOST_CHECK_THROW(doc.root()[0].as_int64(), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_document_should_throw_on_type_mismatch) {
+  const document doc(std::string(R"({"a":[1]})"));
+  BOOST_CHECK_THROW(doc.root().as_string(), std::invalid_argument);
+  BOOST_CHECK_THROW(doc.root().as_bool(), std::invalid_argument);
+  BOOST_CHECK_THROW(doc.root().number_text(), std::invalid_argument);
+  BOOST_CHECK_THROW(doc.root().elements(), std::invalid_argument);
+  BOOST_CHECK_THROW(doc.root()["a"].members(), std::invalid_argument);
+  BOOST_CHECK_THROW(doc.root()["b"], std::out_of_range);
+  BOOST_CHECK_THROW(doc.root()["a"][1], std::out_of_range);
+}
+
+/*
+ * Ownership
+ */
+
+BOOST_AUTO_TEST_CASE(json_document_should_stay_valid_when_moved_and_copied) {
+  document doc(std::string(R"({"a":"x\ty","b":[1,2]})"));
+  document moved(std::move(doc));
+  BOOST_CHECK_EQUAL(moved.root()["a"].as_string(), "x\ty");
+
+  document copy(moved);
+  moved = document();
+  BOOST_CHECK_EQUAL(copy.root()["a"].as_string(), "x\ty");
+  BOOST_CHECK_EQUAL(copy.root()["b"][1].as_int64(), 2);
+
+  copy = copy;
+  BOOST_CHECK_EQUAL(copy.root()["b"].json(), "[1,2]");
+}
+
+/*
+ * Codec
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_document_should_embed_subtrees_in_objects) {
+  auto json = std::string(R"({ "type": "play", "payload": {"uri":"a\/b","n":[1,2]} })");
+  const auto route = decode(route_codec(), json);
+  json.assign(json.size(), ' ');  // The document owns a copy of its text
+
+  BOOST_CHECK_EQUAL(route.type, "play");
+  BOOST_CHECK_EQUAL(route.payload.root()["uri"].as_string(), "a/b");
+  BOOST_CHECK_EQUAL(route.payload.root()["n"][1].as_int64(), 2);
+  BOOST_CHECK_EQUAL(route.payload.root().json(), R"({"uri":"a\/b","n":[1,2]})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_document_should_encode_the_text_of_the_value) {
+  const auto route = decode(route_codec(), R"({"type":"t","payload":[ 1, "\u0041" ]})");
+  BOOST_CHECK_EQUAL(encode(route_codec(), route), R"({"type":"t","payload":[ 1, "\u0041" ]})");
+  BOOST_CHECK_EQUAL(encode(document()), "null");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_document_should_decode_subtrees_with_codecs) {
+  const auto doc = decode<document>(R"({"type":"n","payload":42})");
+  const auto text = doc.root()["payload"].json();
+  BOOST_CHECK_EQUAL(decode(codec::number<int>(), text.data(), text.size()), 42);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_document_should_report_absolute_error_offsets) {
+  const std::string json = R"({"type":"t","payload":[1,}]})";
+  try {
+    decode(route_codec(), json);
+    BOOST_FAIL("Expected a decode_exception");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), json.find('}'));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/optional.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/encode_range.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+/**
+ * A single pass iterator that generates the numbers [0, n) on the fly, and
+ * returns them by value, like a database cursor.
+ */
+struct counting_iterator {
+  using iterator_category = std::input_iterator_tag;
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const int *;
+  using reference = int;
+
+  int operator*() const { return value; }
+  counting_iterator &operator++() { value++; return *this; }
+  bool operator!=(const counting_iterator &other) const { return value != other.value; }
+
+  int value;
+};
+
+struct counting_range {
+  counting_iterator begin() const { return counting_iterator{ 0 }; }
+  counting_iterator end() const { return counting_iterator{ n }; }
+
+  int n;
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_encode_range_should_encode_containers) {
+  BOOST_CHECK_EQUAL(encode_range(codec::number<int>(), std::vector<int>({ 1, 2, 3 })), "[1,2,3]");
+  BOOST_CHECK_EQUAL(encode_range(codec::string(), std::list<std::string>({ "a" })), R"(["a"])");
+  BOOST_CHECK_EQUAL(encode_range(codec::number<int>(), std::vector<int>()), "[]");
+}
+
+BOOST_AUTO_TEST_CASE(json_encode_range_should_encode_single_pass_ranges) {
+  BOOST_CHECK_EQUAL(encode_range(codec::number<int>(), counting_range{ 5 }), "[0,1,2,3,4]");
+}
+
+BOOST_AUTO_TEST_CASE(json_encode_range_should_leave_out_elements_that_should_not_be_encoded) {
+  const auto codec = codec::optional(codec::number<int>());
+  const std::vector<std::optional<int>> values = { std::nullopt, 1, std::nullopt, 2, std::nullopt };
+  BOOST_CHECK_EQUAL(encode_range(codec, values), "[1,2]");
+
+  const std::vector<std::optional<int>> none = { std::nullopt };
+  BOOST_CHECK_EQUAL(encode_range(codec, none), "[]");
+}
+
+BOOST_AUTO_TEST_CASE(json_encode_range_should_flush_to_sink_in_pieces) {
+  encode_range_options options;
+  options.flush_size = 100;
+
+  std::vector<size_t> piece_sizes;
+  std::string json;
+  const counting_range range{ 10000 };
+  encode_range(codec::number<int>(), range.begin(), range.end(), [&](const char *data, size_t size) {
+    piece_sizes.push_back(size);
+    json.append(data, size);
+  }, options);
+
+  std::vector<int> expected;
+  for (int i = 0; i < 10000; i++) {
+    expected.push_back(i);
+  }
+  BOOST_CHECK_EQUAL(json, encode_range(codec::number<int>(), expected));
+  BOOST_CHECK_GT(piece_sizes.size(), 100);
+  for (const auto size : piece_sizes) {
+    BOOST_CHECK_LE(size, 110);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_encode_range_should_write_to_stream) {
+  std::ostringstream stream;
+  encode_range(codec::number<int>(), counting_range{ 3 }, [&](const char *data, size_t size) {
+    stream.write(data, std::streamsize(size));
+  });
+  BOOST_CHECK_EQUAL(stream.str(), "[0,1,2]");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
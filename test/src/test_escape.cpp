@@ -70,6 +70,30 @@ BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_zero_sized_nullptr) {
   BOOST_CHECK_EQUAL(0, context.size());
 }
 
+std::string write_escaped_with(const kernel_tier tier, const char *begin, const char *end) {
+  encode_context context;
+  context.kernels = &kernel_table_for(tier);
+  write_escaped(context, begin, end);
+  return std::string(context.data(), context.size());
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_match_scalar_kernel_for_all_tiers) {
+  std::string input;
+  for (int i = 0; i < 1000; i++) {
+    input += (i % 7 == 0) ? char(i % 0x60) : char('a' + i % 26);
+  }
+
+  const auto end = input.data() + input.size();
+  for (const auto tier : { kernel_tier::sse42, kernel_tier::avx2, kernel_tier::avx512 }) {
+    for (std::size_t offset = 0; offset < 70; offset++) {
+      const auto begin = input.data() + offset;
+      BOOST_CHECK_EQUAL(
+          write_escaped_with(kernel_tier::scalar, begin, end),
+          write_escaped_with(tier, begin, end));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/extract.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+const std::string message = R"({
+  "meta": { "route": "player", "version": 2 },
+  "body": { "tracks": [ { "uri": "a" }, { "uri": "b", "a~b/c": 3 } ] },
+  "key": "escaped"
+})";
+
+std::string text(const std::optional<encoded_value_ref> &value) {
+  BOOST_REQUIRE(value);
+  return std::string(value->data(), value->size());
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_extract_should_find_values) {
+  const auto values = extract(message.data(), message.size(), {
+      "/meta/route", "/body/tracks/1/uri", "/body/tracks/1/a~0b~1c", "/key" });
+  BOOST_REQUIRE_EQUAL(values.size(), 4);
+  BOOST_CHECK_EQUAL(text(values[0]), "\"player\"");
+  BOOST_CHECK_EQUAL(text(values[1]), "\"b\"");
+  BOOST_CHECK_EQUAL(text(values[2]), "3");
+  BOOST_CHECK_EQUAL(text(values[3]), "\"escaped\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_find_containers_and_their_contents) {
+  const auto values = extract(message.data(), message.size(), {
+      "/body/tracks/0/uri", "/body/tracks", "/body/tracks/1", "" });
+  BOOST_CHECK_EQUAL(text(values[0]), "\"a\"");
+  BOOST_CHECK_EQUAL(text(values[1]), R"([ { "uri": "a" }, { "uri": "b", "a~b/c": 3 } ])");
+  BOOST_CHECK_EQUAL(text(values[2]), R"({ "uri": "b", "a~b/c": 3 })");
+  BOOST_CHECK_EQUAL(text(values[3]), message);
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_leave_missing_values_empty) {
+  const auto values = extract(message.data(), message.size(), {
+      "/meta/missing", "/body/tracks/2", "/meta/route/x", "/body/tracks/uri", "/meta/route" });
+  BOOST_CHECK(!values[0]);
+  BOOST_CHECK(!values[1]);
+  BOOST_CHECK(!values[2]);
+  BOOST_CHECK(!values[3]);
+  BOOST_CHECK_EQUAL(text(values[4]), "\"player\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_support_duplicate_pointers) {
+  const auto values = extract(message.data(), message.size(), { "/meta/version", "/meta/version" });
+  BOOST_CHECK_EQUAL(text(values[0]), "2");
+  BOOST_CHECK_EQUAL(text(values[1]), "2");
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_use_the_first_of_duplicate_keys) {
+  const std::string json = R"({"a":{"b":1},"a":{"b":2,"c":3}})";
+  const auto values = extract(json.data(), json.size(), { "/a/b", "/a/c", "/a" });
+  BOOST_CHECK_EQUAL(text(values[0]), "1");
+  BOOST_CHECK_EQUAL(text(values[1]), "3");
+  BOOST_CHECK_EQUAL(text(values[2]), R"({"b":1})");
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_stop_when_all_values_are_found) {
+  const std::string json = R"({"a":1,"b":[1,2,}})";
+  BOOST_CHECK_EQUAL(text(extract(json.data(), json.size(), { "/a" })[0]), "1");
+  BOOST_CHECK_THROW(extract(json.data(), json.size(), { "/a", "/c" }), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_decode_values_with_codecs) {
+  const extractor routing({ "/meta/route", "/meta/version", "/meta/missing" });
+  const auto values = routing.extract(encoded_value_ref(message));
+  BOOST_CHECK_EQUAL(*values.get<std::string>(0), "player");
+  BOOST_CHECK_EQUAL(*values.get(codec::number<int64_t>(), 1), 2);
+  BOOST_CHECK(!values.get<int>(2));
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_report_absolute_decode_offsets) {
+  const auto values = extract(message.data(), message.size(), { "/meta/route" });
+  try {
+    values.get<int>(0);
+    BOOST_FAIL("Expected a decode_exception");
+  } catch (const decode_exception &exception) {
+    const auto begin = message.find("\"player\"");
+    BOOST_CHECK_GE(exception.offset(), begin);
+    BOOST_CHECK_LT(exception.offset(), begin + 8);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_be_reusable) {
+  const extractor routing({ "/id" });
+  BOOST_CHECK_EQUAL(*routing.extract(encoded_value_ref(R"({"id":1})")).get<int>(0), 1);
+  BOOST_CHECK_EQUAL(*routing.extract(encoded_value_ref(R"({"x":[],"id":2})")).get<int>(0), 2);
+  BOOST_CHECK(!routing.extract(encoded_value_ref(R"([1])"))[0]);
+}
+
+BOOST_AUTO_TEST_CASE(json_extract_should_fail_on_malformed_pointers) {
+  BOOST_CHECK_THROW(extractor({ "a" }), std::invalid_argument);
+  BOOST_CHECK_THROW(extractor({ "/a~2" }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/incremental_decoder.hpp>
+
+#include <spotify/json/test/track.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+/**
+ * Feed json to an incremental decoder in chunks of chunk_size bytes, and
+ * return all decoded values.
+ */
+template <typename codec_type>
+std::vector<typename codec_type::object_type> decode_in_chunks(
+    const codec_type &codec,
+    const std::string &json,
+    const size_t chunk_size) {
+  std::vector<typename codec_type::object_type> values;
+  incremental_decoder<codec_type> decoder(codec);
+  for (size_t offset = 0; offset < json.size(); offset += chunk_size) {
+    auto status = decoder.feed(json.substr(offset, chunk_size));
+    while (status == decode_status::ready) {
+      values.push_back(decoder.next());
+      status = decoder.status();
+    }
+    BOOST_CHECK(status == decode_status::need_more_data);
+  }
+
+  while (decoder.finish() == decode_status::ready) {
+    values.push_back(decoder.next());
+  }
+  BOOST_CHECK(decoder.status() == decode_status::done);
+  return values;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_decode_value_split_into_chunks) {
+  const std::string json = R"({"uri":"spotify:track:xyz","ratings":[1,2,3]})";
+  for (size_t chunk_size = 1; chunk_size <= json.size(); chunk_size++) {
+    const auto tracks = decode_in_chunks(track_codec(), json, chunk_size);
+    BOOST_REQUIRE_EQUAL(tracks.size(), 1);
+    BOOST_CHECK_EQUAL(tracks[0].uri, "spotify:track:xyz");
+    BOOST_CHECK(tracks[0].ratings == std::vector<int>({ 1, 2, 3 }));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_decode_concatenated_values) {
+  const std::string json = "[1] [2,3]\n[]\n\n[4]";
+  for (size_t chunk_size = 1; chunk_size <= json.size(); chunk_size++) {
+    const auto values = decode_in_chunks(default_codec<std::vector<int>>(), json, chunk_size);
+    BOOST_REQUIRE_EQUAL(values.size(), 4);
+    BOOST_CHECK(values[1] == std::vector<int>({ 2, 3 }));
+    BOOST_CHECK(values[3] == std::vector<int>({ 4 }));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_decode_scalars) {
+  const auto strings = decode_in_chunks(default_codec<std::string>(), R"("a" "b\"")", 2);
+  BOOST_REQUIRE_EQUAL(strings.size(), 2);
+  BOOST_CHECK_EQUAL(strings[1], "b\"");
+
+  const auto numbers = decode_in_chunks(default_codec<int>(), "1 22\n333", 2);
+  BOOST_CHECK(numbers == std::vector<int>({ 1, 22, 333 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_need_more_data) {
+  incremental_decoder<codec::object_t<track_t>> decoder(track_codec());
+  BOOST_CHECK(decoder.feed(R"({"uri":"a","rat)") == decode_status::need_more_data);
+  BOOST_CHECK_THROW(decoder.next(), decode_exception);
+  BOOST_CHECK(decoder.feed(R"(ings":[]})") == decode_status::ready);
+  BOOST_CHECK_EQUAL(decoder.next().uri, "a");
+  BOOST_CHECK(decoder.status() == decode_status::need_more_data);
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_fail_at_end_of_input_inside_value) {
+  incremental_decoder<codec::object_t<track_t>> decoder(track_codec());
+  BOOST_CHECK(decoder.feed(R"({"uri":)") == decode_status::need_more_data);
+  BOOST_CHECK_THROW(decoder.finish(), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_report_offsets_from_beginning_of_input) {
+  incremental_decoder<codec::object_t<track_t>> decoder(track_codec());
+  BOOST_CHECK(decoder.feed(R"({"uri":"a"} {"uri":1})") == decode_status::ready);
+  decoder.next();
+  try {
+    decoder.next();
+    BOOST_FAIL("next should have thrown");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), 19);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_continue_after_decode_error) {
+  incremental_decoder<codec::object_t<track_t>> decoder(track_codec());
+  decoder.feed(R"({"uri":1} {"uri":"b"})");
+  BOOST_CHECK_THROW(decoder.next(), decode_exception);
+  BOOST_CHECK(decoder.status() == decode_status::ready);
+  BOOST_CHECK_EQUAL(decoder.next().uri, "b");
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_decode_whole_values_in_place) {
+  incremental_decoder<codec::string_view_t> decoder(codec::string_view());
+  const std::string first = R"("abc" "de)";
+  BOOST_CHECK(decoder.feed(first) == decode_status::ready);
+  const auto abc = decoder.next();
+  BOOST_CHECK_EQUAL(abc, "abc");
+  BOOST_CHECK(abc.data() == first.data() + 1);
+  BOOST_CHECK(decoder.status() == decode_status::need_more_data);
+
+  const std::string second = R"(f" "gh" "i)";
+  BOOST_CHECK(decoder.feed(second) == decode_status::ready);
+  BOOST_CHECK_EQUAL(decoder.next(), "def");
+  const auto gh = decoder.next();
+  BOOST_CHECK_EQUAL(gh, "gh");
+  BOOST_CHECK(gh.data() == second.data() + 4);
+  BOOST_CHECK(decoder.feed("\"") == decode_status::ready);
+  BOOST_CHECK_EQUAL(decoder.next(), "i");
+  BOOST_CHECK(decoder.finish() == decode_status::done);
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_fail_after_values_before_mismatched_bracket) {
+  incremental_decoder<codec::number_t<int>> decoder;
+  BOOST_CHECK(decoder.feed("1 2 ]") == decode_status::ready);
+  BOOST_CHECK_EQUAL(decoder.next(), 1);
+  BOOST_CHECK_EQUAL(decoder.next(), 2);
+  try {
+    decoder.status();
+    BOOST_FAIL("status should have thrown");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_incremental_decoder_should_use_default_codec) {
+  incremental_decoder<codec::number_t<int>> decoder;
+  decoder.feed("12");
+  decoder.feed("3");
+  BOOST_CHECK(decoder.finish() == decode_status::ready);
+  BOOST_CHECK_EQUAL(decoder.next(), 123);
+  BOOST_CHECK(decoder.status() == decode_status::done);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
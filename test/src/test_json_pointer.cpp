@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/json_pointer.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+namespace {
+
+using tokens = std::vector<std::string>;
+
+std::string seek(const std::string &json, const char *pointer) {
+  decode_context context(json.data(), json.size());
+  seek_json_pointer(context, parse_json_pointer(pointer));
+  return std::string(context.position, context.end);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_parse_json_pointer_should_split_tokens) {
+  BOOST_CHECK(parse_json_pointer("") == tokens());
+  BOOST_CHECK(parse_json_pointer("/") == tokens({ "" }));
+  BOOST_CHECK(parse_json_pointer("/a/0") == tokens({ "a", "0" }));
+  BOOST_CHECK(parse_json_pointer("/a//") == tokens({ "a", "", "" }));
+  BOOST_CHECK(parse_json_pointer("/a~1b/~0~01") == tokens({ "a/b", "~~1" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_json_pointer_should_fail_on_malformed_pointers) {
+  BOOST_CHECK_THROW(parse_json_pointer("a"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse_json_pointer("/~"), std::invalid_argument);
+  BOOST_CHECK_THROW(parse_json_pointer("/~2"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(json_seek_json_pointer_should_find_values) {
+  const std::string json = R"( {"a": [10, {"": 20, "b\"c": 30}], "d": 40} )";
+  BOOST_CHECK_EQUAL(seek(json, ""), json.substr(1));
+  BOOST_CHECK_EQUAL(seek(json, "/d"), "40} ");
+  BOOST_CHECK_EQUAL(seek(json, "/a/0"), "10, {\"\": 20, \"b\\\"c\": 30}], \"d\": 40} ");
+  BOOST_CHECK_EQUAL(seek(json, "/a/1/"), "20, \"b\\\"c\": 30}], \"d\": 40} ");
+  BOOST_CHECK_EQUAL(seek(json, "/a/1/b\"c"), "30}], \"d\": 40} ");
+}
+
+BOOST_AUTO_TEST_CASE(json_seek_json_pointer_should_fail_on_missing_values) {
+  const std::string json = R"({"a": [10, 20], "b": {}})";
+  BOOST_CHECK_THROW(seek(json, "/c"), decode_exception);
+  BOOST_CHECK_THROW(seek(json, "/a/2"), decode_exception);
+  BOOST_CHECK_THROW(seek(json, "/a/01"), decode_exception);
+  BOOST_CHECK_THROW(seek(json, "/a/-"), decode_exception);
+  BOOST_CHECK_THROW(seek(json, "/a/0/x"), decode_exception);
+  BOOST_CHECK_THROW(seek(json, "/b/x"), decode_exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -14,7 +14,10 @@
  * the License.
  */
 
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include <boost/test/unit_test.hpp>
 
@@ -138,6 +141,48 @@ BOOST_AUTO_TEST_CASE(json_codec_map_should_respect_should_encode) {
   BOOST_CHECK_EQUAL(encode(codec, map), R"({"a":true})");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_map_should_decode_string_view_keys) {
+  const std::string json = R"({"a":true,"b":false})";
+  const auto map = decode<std::map<std::string_view, bool>>(json);
+  BOOST_REQUIRE_EQUAL(map.size(), 2);
+  BOOST_CHECK(map.begin()->first.data() == json.data() + 2);
+  BOOST_CHECK_EQUAL(map.at("a"), true);
+  BOOST_CHECK_EQUAL(map.at("b"), false);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_map_should_decode_escaped_string_view_keys) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"({"a\nb":true})";
+  auto ctx = decode_context(json.data(), json.size());
+  ctx.memory_resource = &arena;
+  const auto map = default_codec<std::unordered_map<std::string_view, bool>>().decode(ctx);
+  BOOST_CHECK_EQUAL(map.size(), 1);
+  BOOST_CHECK_EQUAL(map.at("a\nb"), true);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_map_should_encode_string_view_keys) {
+  std::map<std::string_view, bool> map;
+  map["a\""] = true;
+  BOOST_CHECK_EQUAL(encode(map), R"({"a\"":true})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_map_should_decode_pmr_unordered_map_from_memory_resource) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"({"a":true,"a long key that is not stored inline":false})";
+  decode_context context(json.data(), json.size());
+  context.memory_resource = &arena;
+
+  using map_type = std::pmr::unordered_map<std::pmr::string, bool>;
+  const auto map = default_codec<map_type>().decode(context);
+  BOOST_CHECK(map.get_allocator().resource() == &arena);
+  BOOST_REQUIRE_EQUAL(map.size(), 2);
+  BOOST_CHECK_EQUAL(map.at("a"), true);
+  BOOST_CHECK_EQUAL(map.at("a long key that is not stored inline"), false);
+  for (const auto &element : map) {
+    BOOST_CHECK(element.first.get_allocator().resource() == &arena);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
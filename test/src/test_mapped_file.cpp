@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/decode_file.hpp>
+#include <spotify/json/mapped_file.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+/**
+ * A file in the temporary directory that is removed when it goes out of scope.
+ */
+struct temporary_file {
+  explicit temporary_file(const std::string &contents)
+      : path((std::filesystem::temp_directory_path() / std::to_string(
+            reinterpret_cast<uintptr_t>(this))).string() + "_spotify_json_test.json") {
+    std::ofstream stream(path, std::ios::binary);
+    stream << contents;
+  }
+
+  ~temporary_file() {
+    std::remove(path.c_str());
+  }
+
+  std::string path;
+};
+
+mapped_file_options all_options() {
+  mapped_file_options options;
+  options.sequential = true;
+  options.will_need = true;
+  options.populate = true;
+  options.huge_pages = true;
+  return options;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_map_file_contents) {
+  const temporary_file file("[1, 2, 3]");
+  const mapped_file mapped(file.path);
+  BOOST_CHECK_EQUAL(std::string(mapped.data(), mapped.size()), "[1, 2, 3]");
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_map_empty_file) {
+  const temporary_file file("");
+  const mapped_file mapped(file.path);
+  BOOST_CHECK_EQUAL(mapped.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_be_movable) {
+  const temporary_file file("true");
+  mapped_file mapped(file.path);
+  mapped_file moved(std::move(mapped));
+  BOOST_CHECK_EQUAL(mapped.size(), 0);
+  BOOST_CHECK_EQUAL(std::string(moved.data(), moved.size()), "true");
+
+  const temporary_file other_file("false");
+  mapped = mapped_file(other_file.path);
+  BOOST_CHECK_EQUAL(std::string(mapped.data(), mapped.size()), "false");
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_throw_on_missing_file) {
+  BOOST_CHECK_THROW(mapped_file("/nonexistent/spotify_json_test.json"), std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_file_should_decode_file) {
+  std::string json = "[";
+  for (int i = 0; i < 10000; i++) {
+    json += (i ? "," : "") + std::to_string(i);
+  }
+  json += "]\n";
+
+  const temporary_file file(json);
+  for (const auto &options : { mapped_file_options(), all_options() }) {
+    const auto values = decode_file<std::vector<int>>(file.path, options);
+    BOOST_REQUIRE_EQUAL(values.size(), 10000);
+    BOOST_CHECK_EQUAL(values.back(), 9999);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_file_should_fail_on_invalid_json) {
+  const temporary_file file("[1, 2");
+  BOOST_CHECK_THROW(decode_file<std::vector<int>>(file.path), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_encoded_value_should_validate_json) {
+  const temporary_file valid_file(R"({"a":[1,2]})");
+  const mapped_encoded_value value(valid_file.path);
+  const encoded_value_ref ref = value;
+  BOOST_CHECK_EQUAL(std::string(ref.data(), ref.size()), R"({"a":[1,2]})");
+
+  const temporary_file invalid_file(R"({"a":)");
+  BOOST_CHECK_THROW(mapped_encoded_value(invalid_file.path), decode_exception);
+  BOOST_CHECK_NO_THROW(mapped_encoded_value(
+      invalid_file.path, mapped_file_options(), encoded_value_ref::unsafe_unchecked()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -14,7 +14,12 @@
  * the License.
  */
 
+#include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -57,6 +62,79 @@ void test_decode_fail(const Codec &codec, const std::string &json) {
   BOOST_CHECK_THROW(codec.decode(c), decode_exception);
 }
 
+template <typename T>
+T reference_string_to(const double_conversion::StringToDoubleConverter &converter, const std::string &json, int &bytes_read);
+
+template <>
+double reference_string_to(const double_conversion::StringToDoubleConverter &converter, const std::string &json, int &bytes_read) {
+  return converter.StringToDouble(json.data(), static_cast<int>(json.size()), &bytes_read);
+}
+
+template <>
+float reference_string_to(const double_conversion::StringToDoubleConverter &converter, const std::string &json, int &bytes_read) {
+  return converter.StringToFloat(json.data(), static_cast<int>(json.size()), &bytes_read);
+}
+
+/**
+ * Check that number_t<T> decodes json to exactly the same bits, and consumes
+ * exactly the same characters, as double-conversion does on its own.
+ */
+template <typename T>
+void test_decode_bit_exact(const std::string &json) {
+  using atod_converter = double_conversion::StringToDoubleConverter;
+  static const atod_converter converter(
+      atod_converter::ALLOW_TRAILING_JUNK,
+      std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::quiet_NaN(),
+      nullptr,
+      nullptr);
+
+  int bytes_read = 0;
+  const auto expected = reference_string_to<T>(converter, json, bytes_read);
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  const auto actual = number<T>().decode(c);
+  BOOST_CHECK_MESSAGE(std::memcmp(&expected, &actual, sizeof(T)) == 0, json);
+  BOOST_CHECK_MESSAGE(c.position == c.begin + bytes_read, json);
+}
+
+std::string random_decimal(std::mt19937_64 &random) {
+  const auto num_digits = 1 + random() % 19;
+  const auto num_int_digits = random() % (num_digits + 1);
+  std::string json = (random() % 2 ? "-" : "");
+  for (size_t i = 0; i < num_digits; i++) {
+    if (i == num_int_digits) {
+      json += (i ? "." : "0.");
+    }
+    json += char('0' + random() % 10);
+  }
+  if (random() % 2) {
+    json += "e" + std::to_string(int(random() % 700) - 350);
+  }
+  return json;
+}
+
+std::string reference_to_shortest(const double value) {
+  using dtoa_converter = double_conversion::DoubleToStringConverter;
+  static const dtoa_converter converter(
+      dtoa_converter::UNIQUE_ZERO | dtoa_converter::EMIT_POSITIVE_EXPONENT_SIGN,
+      nullptr, nullptr, 'e', -6, 21, 6, 0);
+  char buffer[32];
+  double_conversion::StringBuilder builder(buffer, sizeof(buffer));
+  converter.ToShortest(value, &builder);
+  return builder.Finalize();
+}
+
+/**
+ * Check that number_t<T> encodes value exactly like double-conversion's
+ * ECMAScript style shortest representation, which is what spotify-json used
+ * to encode floating point numbers with. Like before, floats are encoded as
+ * the doubles they convert to.
+ */
+template <typename T>
+void test_encode_like_double_conversion(const T value) {
+  BOOST_CHECK_EQUAL(encode(number<T>(), value), reference_to_shortest(value));
+}
+
 }  // namespace
 
 BOOST_AUTO_TEST_CASE(json_codec_number_should_construct) {
@@ -124,6 +202,67 @@ BOOST_AUTO_TEST_CASE(json_codec_number_should_not_decode_invalid_float_numbers)
   test_decode_fail(number<float>(), "- 1.1");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_doubles_bit_exactly) {
+  const std::vector<std::string> cases = {
+      "0", "-0", "0.0", "-0.0e10", "0e999999999", "1", "-1", "0.1", "0.3",
+      "123456789012345678", "1234567890123456789", "12345678901234567890",
+      "9007199254740992", "9007199254740993", "9007199254740995",
+      "1e22", "1e23", "4.9e-324", "2.4703282292062327e-324",
+      "2.4703282292062328e-324", "2.2250738585072011e-308",
+      "2.2250738585072012e-308", "1.7976931348623157e308",
+      "1.7976931348623158e308", "1.7976931348623159e308", "1e309", "1e-400",
+      "1e400", "-1e400", "0.000000000000000000000000000001",
+      "00012.5", "7.2057594037927933e16", "1.00000000000000011102230246251565",
+      "3.14159265358979323846264338327950288419716939937510582097494459",
+      "1.5x", "1.", "1.e5", ".5", "+1", "1e", "1e+", "1E-5", "1e-5,", "12]" };
+  for (const auto &json : cases) {
+    test_decode_bit_exact<double>(json);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_floats_bit_exactly) {
+  const std::vector<std::string> cases = {
+      "0", "-0", "0.1", "16777216", "16777217", "16777219", "1e10", "1e11",
+      "3.4028234e38", "3.4028235e38", "3.4028236e38", "1e39", "1.4e-45",
+      "7.006492e-46", "7.006493e-46", "1.1754942e-38", "1.1754943e-38",
+      "1e-50", "0.30000001192092896", "1.00000005960464477539062499" };
+  for (const auto &json : cases) {
+    test_decode_bit_exact<float>(json);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_random_doubles_bit_exactly) {
+  std::mt19937_64 random(1);
+  char buffer[32];
+  for (size_t i = 0; i < 100000; i++) {
+    uint64_t bits = random();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value) || std::isinf(value)) {
+      continue;
+    }
+    std::snprintf(buffer, sizeof(buffer), "%.*g", int(1 + random() % 17), value);
+    test_decode_bit_exact<double>(buffer);
+    test_decode_bit_exact<double>(random_decimal(random));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_random_floats_bit_exactly) {
+  std::mt19937_64 random(2);
+  char buffer[32];
+  for (size_t i = 0; i < 100000; i++) {
+    uint32_t bits = uint32_t(random());
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value) || std::isinf(value)) {
+      continue;
+    }
+    std::snprintf(buffer, sizeof(buffer), "%.*g", int(1 + random() % 9), value);
+    test_decode_bit_exact<float>(buffer);
+    test_decode_bit_exact<float>(random_decimal(random));
+  }
+}
+
 /*
  * Encoding Floating Point Numbers
  */
@@ -133,6 +272,101 @@ BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_exactly) {
   BOOST_CHECK_EQUAL(encode(0.5f), "0.5");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_shortest_representation) {
+  BOOST_CHECK_EQUAL(encode(0.1), "0.1");
+  BOOST_CHECK_EQUAL(encode(0.3), "0.3");
+  BOOST_CHECK_EQUAL(encode(0.1 + 0.2), "0.30000000000000004");
+  BOOST_CHECK_EQUAL(encode(-123.456), "-123.456");
+  BOOST_CHECK_EQUAL(encode(5e-324), "5e-324");
+  BOOST_CHECK_EQUAL(encode(1.7976931348623157e308), "1.7976931348623157e+308");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_floats_as_doubles) {
+  BOOST_CHECK_EQUAL(encode(0.1f), "0.10000000149011612");
+  BOOST_CHECK_EQUAL(encode(1.1f), "1.100000023841858");
+  BOOST_CHECK_EQUAL(encode(3.3f), "3.299999952316284");
+  BOOST_CHECK_EQUAL(encode(-0.25f), "-0.25");
+  BOOST_CHECK_EQUAL(encode(3.4028235e38f), "3.4028234663852886e+38");
+  BOOST_CHECK_EQUAL(encode(1e-45f), "1.401298464324817e-45");
+  BOOST_CHECK_EQUAL(encode(1e21f), "1.0000000200408773e+21");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_with_exponent_outside_of_range) {
+  BOOST_CHECK_EQUAL(encode(0.000001), "0.000001");
+  BOOST_CHECK_EQUAL(encode(0.0000012), "0.0000012");
+  BOOST_CHECK_EQUAL(encode(0.0000001), "1e-7");
+  BOOST_CHECK_EQUAL(encode(-0.00000012), "-1.2e-7");
+  BOOST_CHECK_EQUAL(encode(1e20), "100000000000000000000");
+  BOOST_CHECK_EQUAL(encode(1.5e20), "150000000000000000000");
+  BOOST_CHECK_EQUAL(encode(1e21), "1e+21");
+  BOOST_CHECK_EQUAL(encode(-1.5e21), "-1.5e+21");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_integral_values_as_integers) {
+  BOOST_CHECK_EQUAL(encode(0.0), "0");
+  BOOST_CHECK_EQUAL(encode(-0.0), "0");
+  BOOST_CHECK_EQUAL(encode(-0.0f), "0");
+  BOOST_CHECK_EQUAL(encode(1.0), "1");
+  BOOST_CHECK_EQUAL(encode(-42.0), "-42");
+  BOOST_CHECK_EQUAL(encode(1000000.0f), "1000000");
+  BOOST_CHECK_EQUAL(encode(16777216.0f), "16777216");
+  BOOST_CHECK_EQUAL(encode(16777218.0f), "16777218");
+  BOOST_CHECK_EQUAL(encode(9007199254740991.0), "9007199254740991");
+  BOOST_CHECK_EQUAL(encode(-9007199254740992.0), "-9007199254740992");
+  BOOST_CHECK_EQUAL(encode(9007199254740994.0), "9007199254740994");
+  BOOST_CHECK_EQUAL(encode(1e17), "100000000000000000");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_doubles_like_double_conversion) {
+  for (int exponent = -1074; exponent < 1024; exponent++) {
+    const auto value = std::ldexp(1.0, exponent);
+    test_encode_like_double_conversion(value);
+    test_encode_like_double_conversion(std::nextafter(value, 0.0));
+    test_encode_like_double_conversion(std::nextafter(value, HUGE_VAL));
+  }
+  for (int exponent = -325; exponent < 309; exponent++) {
+    test_encode_like_double_conversion(std::pow(10.0, exponent));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_floats_like_double_conversion) {
+  for (int exponent = -149; exponent < 128; exponent++) {
+    const auto value = std::ldexp(1.0f, exponent);
+    test_encode_like_double_conversion(value);
+    test_encode_like_double_conversion(std::nextafter(value, 0.0f));
+    test_encode_like_double_conversion(std::nextafter(value, HUGE_VALF));
+  }
+  for (int exponent = -46; exponent < 39; exponent++) {
+    test_encode_like_double_conversion(float(std::pow(10.0, exponent)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_random_doubles_like_double_conversion) {
+  std::mt19937_64 random(3);
+  for (size_t i = 0; i < 100000; i++) {
+    uint64_t bits = random();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) {
+      test_encode_like_double_conversion(value);
+    }
+    test_encode_like_double_conversion(double(int64_t(random() % 2000001) - 1000000) / 1000);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_random_floats_like_double_conversion) {
+  std::mt19937_64 random(4);
+  for (size_t i = 0; i < 100000; i++) {
+    uint32_t bits = uint32_t(random());
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value)) {
+      test_encode_like_double_conversion(value);
+    }
+    test_encode_like_double_conversion(float(int64_t(random() % 2000001) - 1000000) / 1000);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_number_should_not_encode_not_a_number) {
   BOOST_CHECK_THROW(encode(number<float>(), NAN), encode_exception);
   BOOST_CHECK_THROW(encode(number<double>(), NAN), encode_exception);
@@ -372,6 +606,55 @@ BOOST_AUTO_TEST_CASE(json_codec_number_should_not_gobble_characters_after_unsign
   BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<uint8_t>(), "15.0#", 4), 15);
 }
 
+/*
+ * Decoding Long Integers
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_long_integers) {
+  BOOST_CHECK_EQUAL(test_decode(number<int32_t>(), "123456789"), 123456789);
+  BOOST_CHECK_EQUAL(test_decode(number<int32_t>(), "2147483647"), INT32_MAX);
+  BOOST_CHECK_EQUAL(test_decode(number<int32_t>(), "-2147483648"), INT32_MIN);
+  BOOST_CHECK_EQUAL(test_decode(number<uint32_t>(), "4294967295"), UINT32_MAX);
+  BOOST_CHECK_EQUAL(test_decode(number<int64_t>(), "1571234567890"), 1571234567890LL);
+  BOOST_CHECK_EQUAL(test_decode(number<int64_t>(), "-1571234567890123"), -1571234567890123LL);
+  BOOST_CHECK_EQUAL(test_decode(number<int64_t>(), "12345678901234567"), 12345678901234567LL);
+  BOOST_CHECK_EQUAL(test_decode(number<int64_t>(), "9223372036854775807"), INT64_MAX);
+  BOOST_CHECK_EQUAL(test_decode(number<int64_t>(), "-9223372036854775808"), INT64_MIN);
+  BOOST_CHECK_EQUAL(test_decode(number<uint64_t>(), "18446744073709551615"), UINT64_MAX);
+  BOOST_CHECK_EQUAL(test_decode(number<uint64_t>(), "00000000000000000000042"), 42);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_not_decode_overflowing_long_integers) {
+  test_decode_fail(number<int32_t>(), "9999999999");
+  test_decode_fail(number<int32_t>(), "-2147483649");
+  test_decode_fail(number<uint32_t>(), "4294967296");
+  test_decode_fail(number<int64_t>(), "-9223372036854775809");
+  test_decode_fail(number<int64_t>(), "99999999999999999999");
+  test_decode_fail(number<uint64_t>(), "18446744073709551616");
+  test_decode_fail(number<uint64_t>(), "123456789012345678901234567890");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_not_gobble_characters_after_long_integer) {
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<int64_t>(), "1234567,89012345", 7), 1234567);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<int64_t>(), "123456789,0123456", 9), 123456789);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<int64_t>(), "1234567890123]", 13), 1234567890123LL);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<int64_t>(), "-12345678901234567/", 18), -12345678901234567LL);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<uint64_t>(), "12345678:12345678", 8), 12345678);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<int32_t>(), "123456789.5e1,", 13), 1234567895);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<int64_t>(), "1234567890123e-3}", 16), 1234567890);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_random_long_integers) {
+  std::mt19937_64 random(5);
+  for (size_t i = 0; i < 100000; i++) {
+    const auto value = int64_t(random() >> (random() % 64));
+    const auto negated = (random() % 2 ? -value : value);
+    BOOST_CHECK_EQUAL(test_decode(number<int64_t>(), std::to_string(negated)), negated);
+    BOOST_CHECK_EQUAL(test_decode(number<uint64_t>(), std::to_string(uint64_t(value) * 2)), uint64_t(value) * 2);
+    BOOST_CHECK_EQUAL(test_decode(number<int32_t>(), std::to_string(int32_t(negated))), int32_t(negated));
+  }
+}
+
 /*
  * Encoding Unsigned Integers
  */
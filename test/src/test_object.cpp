@@ -14,12 +14,16 @@
  * the License.
  */
 
+#include <memory_resource>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/array.hpp>
 #include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/map.hpp>
 #include <spotify/json/codec/object.hpp>
 #include <spotify/json/codec/string.hpp>
 #include <spotify/json/decode.hpp>
@@ -144,6 +148,72 @@ BOOST_AUTO_TEST_CASE(json_codec_object_should_overwrite_duplicate_fields) {
   BOOST_CHECK_EQUAL(example.value, "hey2");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_fields_with_escaped_keys) {
+  const auto simple = test_decode(default_codec<simple_t>(), R"({"v\u0061lue":"hey","\u0073ize":1})");
+  BOOST_CHECK_EQUAL(simple.value, "hey");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_fields_with_special_characters_in_keys) {
+  codec::object_t<simple_t> codec;
+  codec.required("a\"b\\c", &simple_t::value);
+  const auto simple = test_decode(codec, R"({"a\"b\\c":"hey"})");
+  BOOST_CHECK_EQUAL(simple.value, "hey");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_ignore_keys_similar_to_fields) {
+  const auto simple = test_decode(default_codec<simple_t>(), R"({"valu":"a","values":"b","":"c","VALUE":"d"})");
+  BOOST_CHECK_EQUAL(simple.value, "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_fields_in_declared_order) {
+  const auto simple = test_decode(default_codec<simple_t>(), R"({"size":1,"unknown":2,"value":"a"})");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+  BOOST_CHECK_EQUAL(simple.value, "a");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_not_mistake_key_prefixes_for_fields_in_declared_order) {
+  const auto simple = test_decode(default_codec<simple_t>(), R"({"size":1,"val":"a","value" : "b","valueX":"c"})");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+  BOOST_CHECK_EQUAL(simple.value, "b");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_many_fields) {
+  const size_t num_fields = 500;
+  codec::object_t<std::vector<size_t>> codec([]{ return std::vector<size_t>(num_fields); });
+  std::string json = "{";
+  for (size_t i = 0; i < num_fields; i++) {
+    const auto name = "field_with_a_long_common_prefix_" + std::to_string(i);
+    codec.required(name,
+        [i](const std::vector<size_t> &v) { return v[i]; },
+        [i](std::vector<size_t> &v, size_t value) { v[i] = value; });
+    json += (i ? ",\"" : "\"") + name + "\":" + std::to_string(i * 2);
+  }
+  json += "}";
+
+  const auto decoded = test_decode(codec, json);
+  for (size_t i = 0; i < num_fields; i++) {
+    BOOST_CHECK_EQUAL(decoded[i], i * 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_find_fields_saved_after_first_use) {
+  codec::object_t<simple_t> codec;
+  codec.required("size", &simple_t::size);
+  BOOST_CHECK_EQUAL(test_decode(codec, R"({"size":1})").size, 1);
+  BOOST_CHECK_EQUAL(encode(codec, simple_t()), R"({"size":0})");
+
+  codec.required("value", &simple_t::value);
+  codec.required("size", &simple_t::size);  // a duplicate of a name from before the first use
+  codec.required("value", &simple_t::value);  // a duplicate of a name from after the first use
+  const auto copy = codec;
+  const auto simple = test_decode(copy, R"({"size":2,"value":"a"})");
+  BOOST_CHECK_EQUAL(simple.size, 2);
+  BOOST_CHECK_EQUAL(simple.value, "a");
+  BOOST_CHECK_EQUAL(encode(codec, simple), R"({"size":2,"value":"a"})");
+  BOOST_CHECK_THROW(test_decode(codec, R"({"size":2})"), decode_exception);
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_object_should_use_custom_creator_when_decoding) {
   object_t<example_t> codec([]{
     example_t value;
@@ -201,6 +271,34 @@ BOOST_AUTO_TEST_CASE(json_codec_object_should_work_with_base_class_member_ptr) {
   BOOST_CHECK_EQUAL(decode(codec, encode(codec, subclass)).value, subclass.value);
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_pmr_members_into_memory_resource) {
+  struct pmr_members_t {
+    std::pmr::string name;
+    std::pmr::vector<std::pmr::string> tags;
+    std::pmr::unordered_map<std::pmr::string, bool> flags;
+  };
+
+  auto codec = object<pmr_members_t>();
+  codec.required("name", &pmr_members_t::name);
+  codec.required("tags", &pmr_members_t::tags);
+  codec.required("flags", &pmr_members_t::flags);
+
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"({"name":"a name that is too long to be stored inline",)"
+                           R"("tags":["a","b"],"flags":{"c":true}})";
+  decode_context context(json.data(), json.size());
+  context.memory_resource = &arena;
+  const auto value = codec.decode(context);
+
+  BOOST_CHECK_EQUAL(value.name, "a name that is too long to be stored inline");
+  BOOST_CHECK(value.name.get_allocator().resource() == &arena);
+  BOOST_REQUIRE_EQUAL(value.tags.size(), 2);
+  BOOST_CHECK(value.tags.get_allocator().resource() == &arena);
+  BOOST_CHECK(value.tags[1].get_allocator().resource() == &arena);
+  BOOST_CHECK_EQUAL(value.flags.at("c"), true);
+  BOOST_CHECK(value.flags.get_allocator().resource() == &arena);
+}
+
 /*
  * Encoding
  */
@@ -268,6 +366,161 @@ BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_lambda_getter_field) {
   BOOST_CHECK_EQUAL(encode(codec, getset), R"({"value":"foobar"})");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_empty_object) {
+  codec::object_t<simple_t> codec;
+  BOOST_CHECK_EQUAL(encode(codec, simple_t()), "{}");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_fields_with_escaped_keys) {
+  simple_t simple;
+  simple.value = "\"";
+  simple.size = 0;
+
+  codec::object_t<simple_t> codec;
+  codec.required("a\"b", &simple_t::size);
+  codec.required("\n", &simple_t::value);
+  codec.required("", &simple_t::size);
+
+  BOOST_CHECK_EQUAL(encode(codec, simple), R"({"a\"b":0,"\n":"\"","":0})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_nested_objects_with_fixed_fields) {
+  using data_t = std::pair<bool, int>;
+  codec::object_t<data_t> inner;
+  inner.required("b", &data_t::first);
+  inner.required("i", &data_t::second);
+
+  codec::object_t<std::pair<data_t, data_t>> outer;
+  outer.required("x", &std::pair<data_t, data_t>::first, inner);
+  outer.required("y", &std::pair<data_t, data_t>::second, inner);
+
+  const auto data = std::make_pair(data_t(true, -2147483647 - 1), data_t(false, 7));
+  BOOST_CHECK_EQUAL(
+      encode(outer, data),
+      R"({"x":{"b":true,"i":-2147483648},"y":{"b":false,"i":7}})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_respect_should_encode_after_fixed_fields) {
+  using data_t = std::pair<bool, bool>;
+  const auto data = data_t(false, false);
+
+  codec::object_t<data_t> codec;
+  codec.required("first", &data_t::first);
+  codec.optional("second", &data_t::second, only_true_t());
+
+  BOOST_CHECK_EQUAL(encode(codec, data), R"({"first":false})");
+}
+
+/*
+ * Decoding into existing objects
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_into_existing_members) {
+  struct data_t {
+    std::string value = "default";
+    std::vector<int> list;
+  };
+
+  codec::object_t<data_t> codec;
+  codec.optional("value", &data_t::value);
+  codec.optional("list", &data_t::list);
+
+  data_t data;
+  data.value.assign(100, 'x');
+  data.list.assign(100, 7);
+  const auto value_data = data.value.data();
+  const auto list_data = data.list.data();
+
+  const std::string json = R"({"value":"abc","list":[1,2,3]})";
+  decode_context context(json.data(), json.size());
+  codec.decode_into(context, data);
+  BOOST_CHECK_EQUAL(context.position, context.end);
+  BOOST_CHECK_EQUAL(data.value, "abc");
+  BOOST_CHECK(data.list == std::vector<int>({ 1, 2, 3 }));
+  BOOST_CHECK(data.value.data() == value_data);
+  BOOST_CHECK(data.list.data() == list_data);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_reset_missing_fields_when_decoding_into) {
+  struct data_t {
+    std::string value = "default";
+    int number = 17;
+  };
+
+  codec::object_t<data_t> codec;
+  codec.optional("value", &data_t::value);
+  codec.optional("number", &data_t::number);
+
+  data_t data;
+  data.value = "old";
+  data.number = 1;
+
+  const std::string json = R"({"number":2})";
+  decode_context context(json.data(), json.size());
+  codec.decode_into(context, data);
+  BOOST_CHECK_EQUAL(data.value, "default");
+  BOOST_CHECK_EQUAL(data.number, 2);
+
+  const std::string empty_json = "{}";
+  decode_context empty_context(empty_json.data(), empty_json.size());
+  codec.decode_into(empty_context, data);
+  BOOST_CHECK_EQUAL(data.number, 17);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_into_nested_objects) {
+  codec::object_t<example_t> codec;
+  codec.required("simple", &example_t::simple, default_codec<simple_t>());
+  codec.optional("value", &example_t::value);
+
+  example_t example;
+  example.simple.size = 5;
+  example.simple.value = "old";
+  example.value = "old";
+
+  const std::string json = R"({"simple":{"value":"new"}})";
+  decode_context context(json.data(), json.size());
+  codec.decode_into(context, example);
+  BOOST_CHECK_EQUAL(example.simple.size, 0);
+  BOOST_CHECK_EQUAL(example.simple.value, "new");
+  BOOST_CHECK_EQUAL(example.value, "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_into_setters_and_custom_fields) {
+  const auto codec = getset_codec();
+  getset_t getset;
+  getset.set_value("old");
+
+  const std::string json = R"({"value":"new"})";
+  decode_context context(json.data(), json.size());
+  codec.decode_into(context, getset);
+  BOOST_CHECK_EQUAL(getset.get_value(), "new");
+
+  codec::object_t<getset_t> optional_codec;
+  optional_codec.optional("value", &getset_t::get_value, &getset_t::set_value);
+  const std::string empty_json = "{}";
+  decode_context empty_context(empty_json.data(), empty_json.size());
+  optional_codec.decode_into(empty_context, getset);
+  BOOST_CHECK_EQUAL(getset.get_value(), "");
+
+  codec::object_t<getset_t> lambda_codec;
+  lambda_codec.optional("value",
+                        [](const getset_t &x) { return x.get_value(); },
+                        [](getset_t &x, const std::string &value) { x.set_value(value + "!"); });
+  decode_context lambda_context(empty_json.data(), empty_json.size());
+  lambda_codec.decode_into(lambda_context, getset);
+  BOOST_CHECK_EQUAL(getset.get_value(), "!");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_fail_decode_into_without_required_fields) {
+  codec::object_t<simple_t> codec;
+  codec.required("value", &simple_t::value);
+
+  simple_t simple;
+  const std::string json = R"({"size":1})";
+  decode_context context(json.data(), json.size());
+  BOOST_CHECK_THROW(codec.decode_into(context, simple), decode_exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <array>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/parallel_array.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/encode.hpp>
+
+#include <spotify/json/test/track.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+struct playlist_t {
+  std::vector<track_t> tracks;
+};
+
+/**
+ * Options that make every array large enough to be decoded in parallel.
+ */
+parallel_array_options parallel_options(const size_t num_threads = 4) {
+  parallel_array_options options;
+  options.min_size = 0;
+  options.num_threads = num_threads;
+  return options;
+}
+
+std::string make_tracks_json(const size_t num_tracks) {
+  std::string json = "[";
+  for (size_t i = 0; i < num_tracks; i++) {
+    json += (i ? ",\n  " : "\n  ");
+    json += R"({"uri":"spotify:track:)" + std::to_string(i) + R"(,[]{}","ratings":[)";
+    json += std::to_string(i) + "]}";
+  }
+  return json + "\n]";
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_decode_objects_in_order) {
+  const auto json = make_tracks_json(1000);
+  for (const auto num_threads : { 2, 4, 16 }) {
+    const auto codec = parallel_array<std::vector<track_t>>(track_codec(), parallel_options(num_threads));
+    const auto tracks = decode(codec, json);
+    BOOST_REQUIRE_EQUAL(tracks.size(), 1000);
+    for (size_t i = 0; i < tracks.size(); i++) {
+      BOOST_CHECK_EQUAL(tracks[i].uri, "spotify:track:" + std::to_string(i) + ",[]{}");
+      BOOST_CHECK(tracks[i].ratings == std::vector<int>({ int(i) }));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_decode_scalars) {
+  const auto codec = parallel_array<std::vector<std::string>>(string(), parallel_options());
+  BOOST_CHECK(decode(codec, R"([ "a" , "b\"]" ,"c" ])") == std::vector<std::string>({ "a", "b\"]", "c" }));
+  BOOST_CHECK(decode(parallel_array<std::vector<int>>(number<int>(), parallel_options()), "[1,2,3]") ==
+              std::vector<int>({ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_decode_empty_array) {
+  const auto codec = parallel_array<std::vector<int>>(number<int>(), parallel_options());
+  BOOST_CHECK(decode(codec, "[]").empty());
+  BOOST_CHECK(decode(codec, "[ \n ]").empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_decode_into_other_containers) {
+  const auto set_codec = parallel_array<std::set<int>>(number<int>(), parallel_options());
+  BOOST_CHECK(decode(set_codec, "[3,1,2,1]") == std::set<int>({ 1, 2, 3 }));
+
+  const auto array_codec = parallel_array<std::array<int, 3>>(number<int>(), parallel_options());
+  BOOST_CHECK(decode(array_codec, "[1,2,3]") == (std::array<int, 3>{{ 1, 2, 3 }}));
+  BOOST_CHECK_THROW(decode(array_codec, "[1,2]"), decode_exception);
+  BOOST_CHECK_THROW(decode(array_codec, "[1,2,3,4]"), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_decode_nested_in_indexed_input) {
+  object_t<playlist_t> codec;
+  codec.required("tracks", &playlist_t::tracks,
+                 parallel_array<std::vector<track_t>>(track_codec(), parallel_options()));
+
+  const auto json = R"({"skipped":[[{}]],"tracks":)" + make_tracks_json(100) + "}";
+  BOOST_CHECK_EQUAL(decode(codec, json).tracks.size(), 100);
+  BOOST_CHECK_EQUAL(decode_indexed(codec, json).tracks.size(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_fall_back_to_serial_decode) {
+  parallel_array_options options;
+  options.num_threads = 4;
+  const auto codec = parallel_array<std::vector<int>>(number<int>(), options);
+  BOOST_CHECK(decode(codec, "[1,2,3]") == std::vector<int>({ 1, 2, 3 }));
+
+  std::pmr::monotonic_buffer_resource resource;
+  const auto pmr_codec = parallel_array<std::pmr::vector<int>>(number<int>(), parallel_options());
+  const std::string json = "[1,2,3]";
+  decode_context context(json.data(), json.size());
+  context.memory_resource = &resource;
+  const auto values = pmr_codec.decode(context);
+  BOOST_CHECK(values == std::pmr::vector<int>({ 1, 2, 3 }));
+  BOOST_CHECK(values.get_allocator().resource() == &resource);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_fail_with_offset_of_invalid_element) {
+  auto json = make_tracks_json(500);
+  const auto offset = json.find("[321]") + 2;
+  json[offset] = 'x';
+  for (const auto num_threads : { 1, 4 }) {
+    const auto codec = parallel_array<std::vector<track_t>>(track_codec(), parallel_options(num_threads));
+    BOOST_CHECK_EXCEPTION(
+        decode(codec, json),
+        decode_exception,
+        [&](const decode_exception &exception) { return exception.offset() == offset; });
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_fail_on_malformed_arrays) {
+  const auto codec = parallel_array<std::vector<int>>(number<int>(), parallel_options());
+  BOOST_CHECK_THROW(decode(codec, "[1,2,]"), decode_exception);
+  BOOST_CHECK_THROW(decode(codec, "[1,,2]"), decode_exception);
+  BOOST_CHECK_THROW(decode(codec, "[1 2]"), decode_exception);
+  BOOST_CHECK_THROW(decode(codec, "[1,2"), decode_exception);
+  BOOST_CHECK_THROW(decode(codec, "[1,2}"), decode_exception);
+  BOOST_CHECK_THROW(decode(codec, "[1,[2]]"), decode_exception);
+  BOOST_CHECK_THROW(decode(codec, "{}"), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_parallel_array_should_encode_like_array) {
+  const auto codec = parallel_array<std::vector<int>>(number<int>(), parallel_options());
+  BOOST_CHECK_EQUAL(encode(codec, std::vector<int>({ 1, 2, 3 })), "[1,2,3]");
+  BOOST_CHECK_EQUAL(encode(codec, std::vector<int>()), "[]");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
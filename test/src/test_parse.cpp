@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/parse.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+/**
+ * Records the events of a parse as strings, and stops the parse after
+ * stop_after events.
+ */
+struct recording_handler {
+  bool record(std::string event) {
+    events.push_back(std::move(event));
+    return events.size() < stop_after;
+  }
+
+  bool start_object() { return record("{"); }
+  bool key(std::string_view key) { return record("key:" + std::string(key)); }
+  bool end_object() { return record("}"); }
+  bool start_array() { return record("["); }
+  bool end_array() { return record("]"); }
+  bool string(std::string_view string) { return record("string:" + std::string(string)); }
+  bool number_raw(std::string_view number) { return record("number:" + std::string(number)); }
+  bool boolean(bool value) { return record(value ? "true" : "false"); }
+  bool null() { return record("null"); }
+
+  std::vector<std::string> events;
+  size_t stop_after = static_cast<size_t>(-1);
+};
+
+std::vector<std::string> parse_events(const std::string &json) {
+  recording_handler handler;
+  BOOST_CHECK(parse(handler, json));
+  return handler.events;
+}
+
+void parse_should_fail(const std::string &json) {
+  recording_handler handler;
+  BOOST_CHECK_THROW(parse(handler, json), decode_exception);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_parse_should_report_scalars) {
+  BOOST_CHECK(parse_events("\"abc\"") == std::vector<std::string>({ "string:abc" }));
+  BOOST_CHECK(parse_events(" -1.5e+3 ") == std::vector<std::string>({ "number:-1.5e+3" }));
+  BOOST_CHECK(parse_events("true") == std::vector<std::string>({ "true" }));
+  BOOST_CHECK(parse_events("false") == std::vector<std::string>({ "false" }));
+  BOOST_CHECK(parse_events("null") == std::vector<std::string>({ "null" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_leave_escape_sequences_in_strings) {
+  BOOST_CHECK(parse_events(R"(["a\"b\u00e5"])") ==
+              std::vector<std::string>({ "[", R"(string:a\"b\u00e5)", "]" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_report_nested_values_in_order) {
+  const auto events = parse_events(R"( { "a" : [1, {"b":null}, []], "c": {}, "d": "x" } )");
+  BOOST_CHECK(events == std::vector<std::string>({
+      "{",
+      "key:a", "[", "number:1", "{", "key:b", "null", "}", "[", "]", "]",
+      "key:c", "{", "}",
+      "key:d", "string:x",
+      "}" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_handle_deep_nesting) {
+  const auto depth = 1000;
+  const auto json = std::string(depth, '[') + std::string(depth, ']');
+  const auto events = parse_events(json);
+  BOOST_REQUIRE_EQUAL(events.size(), 2 * depth);
+  BOOST_CHECK_EQUAL(events.front(), "[");
+  BOOST_CHECK_EQUAL(events.back(), "]");
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_stop_when_handler_returns_false) {
+  recording_handler handler;
+  handler.stop_after = 3;
+  BOOST_CHECK(!parse(handler, R"({"a":1,"b":2} trailing garbage)"));
+  BOOST_CHECK(handler.events == std::vector<std::string>({ "{", "key:a", "number:1" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_accept_partial_handlers) {
+  struct counting_handler : public parse_handler {
+    bool number_raw(std::string_view) {
+      count++;
+      return true;
+    }
+
+    size_t count = 0;
+  };
+
+  counting_handler handler;
+  BOOST_CHECK(parse(handler, R"({"a":[1,2,{"b":3}],"c":"4"})"));
+  BOOST_CHECK_EQUAL(handler.count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_fail_on_invalid_json) {
+  parse_should_fail("");
+  parse_should_fail("[");
+  parse_should_fail("[1,]");
+  parse_should_fail("[1 2]");
+  parse_should_fail("[}");
+  parse_should_fail("{\"a\"}");
+  parse_should_fail("{\"a\":1,}");
+  parse_should_fail("{1:1}");
+  parse_should_fail("{\"a\":1]");
+  parse_should_fail("\"abc");
+  parse_should_fail("\"\\x\"");
+  parse_should_fail("01");
+  parse_should_fail("-");
+  parse_should_fail("tru");
+  parse_should_fail("1 2");
+  parse_should_fail("x");
+}
+
+BOOST_AUTO_TEST_CASE(json_parse_should_fail_with_offset) {
+  recording_handler handler;
+  try {
+    parse(handler, "[1, x]");
+    BOOST_FAIL("parse should have failed");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), 4);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -36,14 +36,22 @@ std::string generate(const std::string &tpl, const std::size_t count) {
   return ws;
 }
 
+/**
+ * Restrict the context to kernels up to and including the given tier. If the
+ * CPU does not support the tier, a narrower kernel will be used instead.
+ */
+void use_tier(decode_context &context, const int tier) {
+  context.kernels = &kernel_table_for(kernel_tier(tier));
+}
+
 template <void (*function)(decode_context &)>
 void verify_skip_any(
-    const bool use_sse,
+    const int tier,
     const std::string &json,
     const std::size_t prefix = 0,
     const std::size_t suffix = 0) {
   auto context = decode_context(json.data() + prefix, json.data() + json.size());
-  *const_cast<bool *>(&context.has_sse42) &= use_sse;
+  use_tier(context, tier);
   const auto original_context = context;
   function(context);
   BOOST_CHECK_EQUAL(
@@ -55,15 +63,19 @@ void verify_skip_any(
 }
 
 template <void (*function)(decode_context &)>
-void verify_skip_empty_nullptr(const bool use_sse) {
+void verify_skip_empty_nullptr(const int tier) {
   auto context = decode_context(nullptr, nullptr);
-  *const_cast<bool *>(&context.has_sse42) &= use_sse;
+  use_tier(context, tier);
   function(context);
   BOOST_CHECK(context.position == nullptr);
   BOOST_CHECK(context.end == nullptr);
 }
 
-using true_false = boost::mpl::list<boost::true_type, boost::false_type>;
+using all_tiers = boost::mpl::list<
+    boost::integral_constant<int, int(kernel_tier::scalar)>,
+    boost::integral_constant<int, int(kernel_tier::sse42)>,
+    boost::integral_constant<int, int(kernel_tier::avx2)>,
+    boost::integral_constant<int, int(kernel_tier::avx512)>>;
 
 }  // namespace
 
@@ -71,94 +83,107 @@ using true_false = boost::mpl::list<boost::true_type, boost::false_type>;
  * skip_any_simple_characters
  */
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters, tier, all_tiers) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("abcdefghIJKLMNOP:-,;'^¨´`xyz", n);
     const auto with_prefix = "\\" + ws;
     const auto with_suffix = ws + "\"abcde";
-    verify_skip_any<skip_any_simple_characters>(use_sse::value, ws);
-    verify_skip_any<skip_any_simple_characters>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_simple_characters>(use_sse::value, with_suffix, 0, 6);
+    verify_skip_any<skip_any_simple_characters>(tier::value, ws);
+    verify_skip_any<skip_any_simple_characters>(tier::value, with_prefix, 1);
+    verify_skip_any<skip_any_simple_characters>(tier::value, with_suffix, 0, 6);
   }
 }
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters_null_byte_in_string,
-                              use_sse,
-                              true_false) {
+                              tier,
+                              all_tiers) {
   alignas(16) char input_data[17] = "a\0\"\"\"\"\"\"\"\"\"\"\"\"\"\"";
   auto context = decode_context(input_data, input_data + 16);
-  *const_cast<bool *>(&context.has_sse42) &= use_sse::value;
+  use_tier(context, tier::value);
   skip_any_simple_characters(context);
   BOOST_CHECK_EQUAL(context.position - input_data, 2);
 }
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters_with_empty_string,
-                              use_sse,
-                              true_false) {
-  verify_skip_empty_nullptr<skip_any_simple_characters>(use_sse::value);
+                              tier,
+                              all_tiers) {
+  verify_skip_empty_nullptr<skip_any_simple_characters>(tier::value);
 }
 
 /*
  * skip_any_whitespace
  */
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_space, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_space, tier, all_tiers) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate(" ", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(tier::value, ws);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_tabs, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_tabs, tier, all_tiers) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\t", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(tier::value, ws);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_carriage_return, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_carriage_return, tier, all_tiers) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\r", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(tier::value, ws);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_line_feed, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_line_feed, tier, all_tiers) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\n", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(tier::value, ws);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace, tier, all_tiers) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\n\t\r\n", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(tier::value, ws);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(tier::value, with_suffix, 0, 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace_stop_at_similar_characters, tier, all_tiers) {
+  // These characters share their low nibble with one of the whitespace
+  // characters, or have the high bit set.
+  const char similar[] = { 0x00, 0x10, 0x30, 0x19, 0x29, 0x1A, 0x2A, 0x1D, 0x2D,
+                           char(0x80), char(0xA0), char(0x8D), char(0xFF) };
+  for (const auto c : similar) {
+    for (auto n = 0; n < 130; n++) {
+      const auto ws = generate(" \t\r\n", n);
+      verify_skip_any<skip_any_whitespace>(tier::value, ws + c + "  ", 0, 3);
+    }
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace_with_empty_string, use_sse, true_false) {
-  verify_skip_empty_nullptr<skip_any_whitespace>(use_sse::value);
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace_with_empty_string, tier, all_tiers) {
+  verify_skip_empty_nullptr<skip_any_whitespace>(tier::value);
 }
 
 BOOST_AUTO_TEST_SUITE_END()  // detail
@@ -15,6 +15,7 @@
  */
 
 #include <string>
+#include <memory_resource>
 
 #include <boost/test/unit_test.hpp>
 
@@ -109,6 +110,33 @@ BOOST_AUTO_TEST_CASE(json_codec_shared_ptr_should_not_encode_null) {
   BOOST_CHECK(!detail::should_encode(codec, obj));
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_shared_ptr_should_allocate_from_memory_resource) {
+  struct counting_resource_t : std::pmr::memory_resource {
+    size_t allocations = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+      allocations++;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+  } resource;
+
+  const std::string json = "\"hello\"";
+  decode_context context(json.data(), json.size());
+  context.memory_resource = &resource;
+  const auto obj = default_codec<std::shared_ptr<std::string>>().decode(context);
+  BOOST_REQUIRE(obj);
+  BOOST_CHECK_EQUAL(*obj, "hello");
+  BOOST_CHECK_EQUAL(resource.allocations, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/static_object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+template <typename Codec>
+typename Codec::object_type test_decode(const Codec &codec, const std::string &json) {
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  auto obj = codec.decode(c);
+  BOOST_CHECK_EQUAL(c.position, c.end);
+  return obj;
+}
+
+template <typename Codec>
+void test_decode_fail(const Codec &codec, const std::string &json) {
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  BOOST_CHECK_THROW(codec.decode(c), decode_exception);
+}
+
+struct simple_t {
+  int size = 0;
+  std::string value;
+};
+
+auto simple_codec() {
+  return static_object<simple_t>(
+      required_field("size", &simple_t::size),
+      optional_field("value", &simple_t::value));
+}
+
+struct escaped_t {
+  std::string value;
+};
+
+constexpr codec_detail::static_key<6> escaped_key("a\"\n\x01z");
+static_assert(escaped_key.escaped_size == 15, "keys should be escaped at compile time");
+
+}  // namespace
+
+/*
+ * Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_fields) {
+  const auto simple = test_decode(simple_codec(), R"({"size":123,"value":"hey"})");
+  BOOST_CHECK_EQUAL(simple.size, 123);
+  BOOST_CHECK_EQUAL(simple.value, "hey");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_fields_in_any_order) {
+  const auto simple = test_decode(simple_codec(), R"({ "value" : "hey" , "size" : 123 })");
+  BOOST_CHECK_EQUAL(simple.size, 123);
+  BOOST_CHECK_EQUAL(simple.value, "hey");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_fields_with_escaped_keys) {
+  const auto simple = test_decode(simple_codec(), R"({"\u0073ize":1,"v\u0061lue":"hey"})");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+  BOOST_CHECK_EQUAL(simple.value, "hey");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_fields_with_special_characters_in_keys) {
+  const auto codec = static_object<escaped_t>(required_field("a\"b\\c", &escaped_t::value));
+  BOOST_CHECK_EQUAL(test_decode(codec, R"({"a\"b\\c":"hey"})").value, "hey");
+  BOOST_CHECK_EQUAL(test_decode(codec, R"({"a\u0022b\u005Cc":"hey"})").value, "hey");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_skip_unknown_fields) {
+  const auto simple = test_decode(simple_codec(), R"({"siz":[1],"size":1,"sizes":{"a":2},"value":"b"})");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+  BOOST_CHECK_EQUAL(simple.value, "b");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_require_required_fields) {
+  test_decode_fail(simple_codec(), "{}");
+  test_decode_fail(simple_codec(), R"({"value":"hey"})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_not_require_optional_fields) {
+  const auto simple = test_decode(simple_codec(), R"({"size":1})");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+  BOOST_CHECK_EQUAL(simple.value, "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_use_provided_codec) {
+  const auto codec = static_object<simple_t>(
+      required_field("size", &simple_t::size, number<int>()),
+      required_field("value", &simple_t::value, string()));
+  const auto simple = test_decode(codec, R"({"size":5,"value":"x"})");
+  BOOST_CHECK_EQUAL(simple.size, 5);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_fail_on_invalid_input) {
+  test_decode_fail(simple_codec(), R"({"size":1,})");
+  test_decode_fail(simple_codec(), R"({"size" 1})");
+  test_decode_fail(simple_codec(), R"({"size":1)");
+  test_decode_fail(simple_codec(), R"({"size)");
+}
+
+/*
+ * Encoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_encode_fields) {
+  simple_t simple;
+  simple.size = 1;
+  simple.value = "hey";
+  BOOST_CHECK_EQUAL(encode(simple_codec(), simple), R"({"size":1,"value":"hey"})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_encode_like_object_codec) {
+  escaped_t escaped;
+  escaped.value = "x";
+
+  object_t<escaped_t> dynamic_codec;
+  dynamic_codec.required("a\"\n\x01z", &escaped_t::value);
+  const auto static_codec = static_object<escaped_t>(
+      required_field("a\"\n\x01z", &escaped_t::value));
+
+  BOOST_CHECK_EQUAL(encode(static_codec, escaped), encode(dynamic_codec, escaped));
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_encode_empty_object) {
+  BOOST_CHECK_EQUAL(encode(static_object<simple_t>(), simple_t()), "{}");
+}
+
+/*
+ * Decoding into existing objects
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_into_existing_object) {
+  simple_t simple;
+  simple.size = 3;
+  simple.value.assign(100, 'x');
+  const auto value_data = simple.value.data();
+
+  const std::string json = R"({"value":"abc","size":7})";
+  decode_context context(json.data(), json.size());
+  simple_codec().decode_into(context, simple);
+  BOOST_CHECK_EQUAL(context.position, context.end);
+  BOOST_CHECK_EQUAL(simple.size, 7);
+  BOOST_CHECK_EQUAL(simple.value, "abc");
+  BOOST_CHECK(simple.value.data() == value_data);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_reset_missing_fields_when_decoding_into) {
+  simple_t simple;
+  simple.size = 3;
+  simple.value = "old";
+
+  const std::string json = R"({"size":7})";
+  decode_context context(json.data(), json.size());
+  simple_codec().decode_into(context, simple);
+  BOOST_CHECK_EQUAL(simple.size, 7);
+  BOOST_CHECK_EQUAL(simple.value, "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_pmr_members_into_memory_resource) {
+  struct pmr_members_t {
+    std::pmr::string name;
+    std::pmr::vector<std::pmr::string> tags;
+  };
+
+  const auto codec = static_object<pmr_members_t>(
+      required_field("name", &pmr_members_t::name),
+      required_field("tags", &pmr_members_t::tags));
+
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"({"name":"a name that is too long to be stored inline","tags":["a","b"]})";
+  decode_context context(json.data(), json.size());
+  context.memory_resource = &arena;
+  const auto value = codec.decode(context);
+
+  BOOST_CHECK_EQUAL(value.name, "a name that is too long to be stored inline");
+  BOOST_CHECK(value.name.get_allocator().resource() == &arena);
+  BOOST_REQUIRE_EQUAL(value.tags.size(), 2);
+  BOOST_CHECK(value.tags.get_allocator().resource() == &arena);
+  BOOST_CHECK(value.tags[1].get_allocator().resource() == &arena);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
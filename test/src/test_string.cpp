@@ -14,12 +14,16 @@
  * the License.
  */
 
+#include <array>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/codec/map.hpp>
 #include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/object.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/decode_exception.hpp>
 #include <spotify/json/encode.hpp>
@@ -349,6 +353,129 @@ BOOST_AUTO_TEST_CASE(json_codec_string_should_encode_long_string_with_special_ch
   BOOST_CHECK(encode(input_str) == expected_result);
 }
 
+/*
+ * string_view
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_point_into_input_without_escapes) {
+  const std::string json = R"("spotify:track:xyz")";
+  auto ctx = decode_context(json.data(), json.size());
+  const auto view = default_codec<std::string_view>().decode(ctx);
+  BOOST_CHECK_EQUAL(view, "spotify:track:xyz");
+  BOOST_CHECK(view.data() == json.data() + 1);
+  BOOST_CHECK_EQUAL(ctx.position, ctx.end);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_decode_empty_string) {
+  BOOST_CHECK_EQUAL(decode<std::string_view>(R"("")"), "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_unescape_into_memory_resource) {
+  std::array<char, 256> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+  const std::string json = R"("a\"b€\n")";
+  auto ctx = decode_context(json.data(), json.size());
+  ctx.memory_resource = &arena;
+  const auto view = codec::string_view().decode(ctx);
+  BOOST_CHECK_EQUAL(view, "a\"b\xE2\x82\xAC\n");
+  BOOST_CHECK(view.data() >= buffer.data() && view.data() < buffer.data() + buffer.size());
+  BOOST_CHECK_EQUAL(ctx.position, ctx.end);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_unescape_with_one_allocation) {
+  struct counting_resource : std::pmr::memory_resource {
+    size_t num_allocations = 0;
+    size_t num_bytes = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+      num_allocations++;
+      num_bytes += bytes;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+      return (this == &other);
+    }
+  } resource;
+
+  const std::string json = R"("\u00e9\ud83d\ude00 \"x\\",1234567890)";
+  auto ctx = decode_context(json.data(), json.size());
+  ctx.memory_resource = &resource;
+  const auto view = codec::string_view().decode(ctx);
+  BOOST_CHECK_EQUAL(view, "\xC3\xA9\xF0\x9F\x98\x80 \"x\\");
+  BOOST_CHECK_EQUAL(ctx.position, json.data() + json.find(','));
+  BOOST_CHECK_EQUAL(resource.num_allocations, 1);
+  BOOST_CHECK_EQUAL(resource.num_bytes, json.find(',') - 1);
+  resource.deallocate(const_cast<char *>(view.data()), resource.num_bytes, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_fail_on_escapes_without_memory_resource) {
+  const std::string json = R"("abc\n")";
+  auto ctx = decode_context(json.data(), json.size());
+  try {
+    codec::string_view().decode(ctx);
+    BOOST_FAIL("decode should have thrown");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_fail_on_unterminated_string) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"("abc\n)";
+  auto ctx = decode_context(json.data(), json.size());
+  ctx.memory_resource = &arena;
+  BOOST_CHECK_THROW(codec::string_view().decode(ctx), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_encode_escaped_characters) {
+  BOOST_CHECK_EQUAL(encode(std::string_view("a\"b\n")), R"("a\"b\n")");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_decode_object_members) {
+  struct track_t {
+    std::string_view uri;
+    std::string_view name;
+  };
+
+  object_t<track_t> codec;
+  codec.required("uri", &track_t::uri);
+  codec.required("name", &track_t::name);
+
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"({"uri":"spotify:track:xyz","name":"\"Heroes\""})";
+  auto ctx = decode_context(json.data(), json.size());
+  ctx.memory_resource = &arena;
+  const auto track = codec.decode(ctx);
+  BOOST_CHECK_EQUAL(track.uri, "spotify:track:xyz");
+  BOOST_CHECK_EQUAL(track.name, "\"Heroes\"");
+  BOOST_CHECK_EQUAL(encode(codec, track), json);
+}
+
+/*
+ * pmr::string
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_pmr_string_should_decode_from_memory_resource) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::string json = R"("a string that is too long to be stored inline\t")";
+  auto ctx = decode_context(json.data(), json.size());
+  ctx.memory_resource = &arena;
+  const auto string = default_codec<std::pmr::string>().decode(ctx);
+  BOOST_CHECK(string.get_allocator().resource() == &arena);
+  BOOST_CHECK_EQUAL(string, "a string that is too long to be stored inline\t");
+  BOOST_CHECK_EQUAL(ctx.position, ctx.end);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_pmr_string_should_encode) {
+  BOOST_CHECK_EQUAL(encode(std::pmr::string("a\"b")), R"("a\"b")");
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <string>
+
+#include <boost/mpl/list.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/ignore.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/detail/structural_index.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+namespace {
+
+using all_tiers = boost::mpl::list<
+    boost::integral_constant<int, int(kernel_tier::scalar)>,
+    boost::integral_constant<int, int(kernel_tier::sse42)>,
+    boost::integral_constant<int, int(kernel_tier::avx2)>,
+    boost::integral_constant<int, int(kernel_tier::avx512)>>;
+
+/**
+ * Find the closing bracket of the bracket at json[offset] with the structural
+ * index, and compare with where skip_value ends up without one.
+ */
+void verify_matching_close(const int tier, const std::string &json, const std::size_t offset = 0) {
+  const auto begin = json.data();
+  const auto end = begin + json.size();
+  const structural_index index(begin, end, kernel_table_for(kernel_tier(tier)));
+
+  auto context = decode_context(begin + offset, end);
+  skip_value(context);
+  BOOST_CHECK_EQUAL(index.find_matching_close(begin + offset), context.position - 1);
+}
+
+std::string nest(const std::string &inner, const std::size_t depth) {
+  return std::string(depth, '[') + inner + std::string(depth, ']');
+}
+
+struct example_t {
+  std::string known;
+};
+
+codec::object_t<example_t> example_codec() {
+  auto codec = codec::object<example_t>();
+  codec.required("known", &example_t::known);
+  return codec;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_structural_index_should_find_matching_close, tier, all_tiers) {
+  verify_matching_close(tier::value, "[]");
+  verify_matching_close(tier::value, "{}");
+  verify_matching_close(tier::value, "[1,[2,{\"a\":[3]}],4] ");
+  verify_matching_close(tier::value, "{\"a\":[1,2],\"b\":{\"c\":{}}}");
+  verify_matching_close(tier::value, "[[],[[]],[[[]]]]", 1);
+  verify_matching_close(tier::value, "[[],[[]],[[[]]]]", 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_structural_index_should_ignore_brackets_in_strings, tier, all_tiers) {
+  verify_matching_close(tier::value, "[\"]\"]");
+  verify_matching_close(tier::value, "{\"}\":\"{\"}");
+  verify_matching_close(tier::value, R"(["\\"])");
+  verify_matching_close(tier::value, R"(["\"]"])");
+  verify_matching_close(tier::value, R"(["\\\"]\\"])");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_structural_index_should_carry_state_across_blocks, tier, all_tiers) {
+  for (std::size_t padding = 0; padding < 130; padding++) {
+    const auto filler = std::string(padding, 'x');
+    verify_matching_close(tier::value, "[\"" + filler + "]\",[]]");
+    verify_matching_close(tier::value, "[\"" + filler + R"(\\\"]","\\"])");
+    verify_matching_close(tier::value, "[\"" + filler + R"(\\\\",[]])");
+    verify_matching_close(tier::value, "[" + std::string(padding, ' ') + "]");
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_structural_index_should_skip_deeply_nested_values, tier, all_tiers) {
+  verify_matching_close(tier::value, nest("", 1000));
+  verify_matching_close(tier::value, nest("1", 1000), 500);
+}
+
+BOOST_AUTO_TEST_CASE(json_structural_index_should_return_nullptr_for_unclosed_bracket) {
+  const std::string json = "[[]";
+  const structural_index index(json.data(), json.data() + json.size());
+  BOOST_CHECK(index.find_matching_close(json.data()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(json_skip_value_with_structural_index) {
+  const std::string json = "{\"a\":[1,2,{\"b\":\"]}\"}]} ";
+  const structural_index index(json.data(), json.data() + json.size());
+  auto context = decode_context(json.data(), json.data() + json.size());
+  context.structural_index = &index;
+  skip_value(context);
+  BOOST_CHECK_EQUAL(context.position, json.data() + json.size() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_skip_value_with_structural_index_should_fail_on_mismatched_brackets) {
+  const std::string json = "{\"a\":[1,2}";
+  const structural_index index(json.data(), json.data() + json.size());
+  auto context = decode_context(json.data(), json.data() + json.size());
+  context.structural_index = &index;
+  BOOST_CHECK_THROW(skip_value(context), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_skip_value_with_structural_index_should_fail_on_unclosed_bracket) {
+  const std::string json = "[[1,2]";
+  const structural_index index(json.data(), json.data() + json.size());
+  auto context = decode_context(json.data(), json.data() + json.size());
+  context.structural_index = &index;
+  BOOST_CHECK_THROW(skip_value(context), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_indexed_should_skip_unknown_fields) {
+  const auto json = std::string(
+      "{\"unknown\":{\"a\":[1,2,{\"b\":\"}\"}]},\"known\":\"value\",\"other\":[[\"[\"]]}");
+  const auto example = decode_indexed(example_codec(), json);
+  BOOST_CHECK_EQUAL(example.known, "value");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_indexed_should_fail_on_invalid_input) {
+  BOOST_CHECK_THROW(decode_indexed(example_codec(), std::string("{\"unknown\":[}")), decode_exception);
+  BOOST_CHECK_THROW(decode_indexed(example_codec(), std::string("{\"known\":\"value\"")), decode_exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <algorithm>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/value_scanner.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+namespace {
+
+/**
+ * Scan json one chunk of chunk_size bytes at a time, and return the offset of
+ * the end of the first value, or json_size_t_max if more data is needed.
+ */
+size_t scan_in_chunks(const std::string &json, const size_t chunk_size) {
+  value_scanner scanner;
+  for (size_t offset = 0; offset < json.size(); offset += chunk_size) {
+    const auto begin = json.data() + offset;
+    const auto end = json.data() + std::min(offset + chunk_size, json.size());
+    if (const auto value_end = scanner.scan(begin, end)) {
+      return size_t(value_end - json.data());
+    }
+  }
+  return json_size_t_max;
+}
+
+void verify_value_end(const std::string &json, const size_t value_end) {
+  for (size_t chunk_size = 1; chunk_size <= json.size(); chunk_size++) {
+    BOOST_CHECK_EQUAL(scan_in_chunks(json, chunk_size), value_end);
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_find_end_of_containers) {
+  verify_value_end("{}", 2);
+  verify_value_end("  []  ", 4);
+  verify_value_end(R"({"a":[1,{"b":[]}],"c":{}} {})", 25);
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_find_end_of_strings) {
+  verify_value_end(R"("abc" )", 5);
+  verify_value_end(R"("a\"b\\" )", 8);
+  verify_value_end(R"(["]}\"{["] )", 10);
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_end_scalars_at_delimiters) {
+  verify_value_end("123 ", 3);
+  verify_value_end("true\n", 4);
+  verify_value_end("-1.5e3[", 6);
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_need_more_data_for_partial_values) {
+  BOOST_CHECK_EQUAL(scan_in_chunks(R"({"a":[1,2])", 3), json_size_t_max);
+  BOOST_CHECK_EQUAL(scan_in_chunks(R"("abc\")", 1), json_size_t_max);
+  BOOST_CHECK_EQUAL(scan_in_chunks("123", 2), json_size_t_max);
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_handle_deep_nesting) {
+  const auto depth = 1000;
+  const auto json = std::string(depth, '[') + std::string(depth, ']');
+  verify_value_end(json, json.size());
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_end_scalars_at_end_of_input) {
+  value_scanner scanner;
+  const std::string json = "123";
+  BOOST_CHECK(!scanner.scan(json.data(), json.data() + json.size()));
+  BOOST_CHECK(scanner.finish());
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_not_end_without_value) {
+  value_scanner scanner;
+  const std::string json = " \n";
+  BOOST_CHECK(!scanner.scan(json.data(), json.data() + json.size()));
+  BOOST_CHECK(!scanner.finish());
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_fail_at_end_of_input_inside_value) {
+  value_scanner scanner;
+  const std::string json = "[1,";
+  BOOST_CHECK(!scanner.scan(json.data(), json.data() + json.size()));
+  BOOST_CHECK_THROW(scanner.finish(), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_fail_on_mismatched_brackets) {
+  value_scanner scanner;
+  const std::string json = "[1,{]";
+  try {
+    scanner.scan(json.data(), json.data() + json.size());
+    BOOST_FAIL("scan should have thrown");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.offset(), 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_fail_on_unexpected_close) {
+  value_scanner scanner;
+  const std::string json = " ]";
+  BOOST_CHECK_THROW(scanner.scan(json.data(), json.data() + json.size()), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_value_scanner_should_scan_again_after_reset) {
+  value_scanner scanner;
+  const std::string json = "[[1] [2]";
+  BOOST_CHECK(!scanner.scan(json.data(), json.data() + json.size()));
+  scanner.reset();
+  BOOST_CHECK(scanner.scan(json.data() + 5, json.data() + json.size()) == json.data() + json.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify